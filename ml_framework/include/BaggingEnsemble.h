@@ -0,0 +1,61 @@
+// include/BaggingEnsemble.h
+#ifndef BAGGING_ENSEMBLE_H
+#define BAGGING_ENSEMBLE_H
+
+#include "Model.h"
+#include "TrainingConfig.h"
+#include <Eigen/Dense>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// Bagging / subespaços aleatórios sobre qualquer Model<T>. Os B membros
+// (config.ensemble_size) são treinados em paralelo sobre o mesmo X:
+//  - bootstrap vira pesos por amostra (multiplicidades), repassados a
+//    PocketPLA/LinearRegression via trainWeighted, sem copiar linhas;
+//  - subespaço (feature_fraction < 1) sorteia colunas por membro; a coluna 0
+//    (bias, convenção do framework) é sempre mantida. As colunas são reunidas
+//    num buffer n x k por thread, reaproveitado entre os membros.
+// Outros modelos recebem a amostra materializada (fallback).
+// Se todos os membros são lineares, os pesos ficam empilhados numa matriz
+// d x B e predict é um único GEMM seguido de voto ou média.
+template<typename T>
+class BaggingEnsemble : public Model<T> {
+public:
+    using MemberFactory = std::function<std::shared_ptr<Model<T>>()>;
+
+    explicit BaggingEnsemble(MemberFactory factory, const TrainingConfig<T>& config = TrainingConfig<T>());
+
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void saveWeights(const std::string& filename) const override;
+    void loadWeights(const std::string& filename) override;
+
+    // Pesos empilhados d x B achatados (column-major); só para membros lineares
+    Eigen::VectorX<T> getWeights() const override;
+    void setWeights(const Eigen::VectorX<T>& new_weights) override;
+
+    // Agregado antes do sign: soma dos votos ou média das saídas dos membros
+    Eigen::VectorX<T> decisionFunction(const MatrixRef<T>& X) const;
+
+    int getMemberCount() const { return static_cast<int>(members.size()); }
+    Model<T>& getMember(int b) { return *members.at(b); }
+    const Eigen::MatrixX<T>& getStackedWeights() const { return stacked_weights; }
+    bool isLinear() const { return linear; }
+    void setConfig(const TrainingConfig<T>& new_config) { config = new_config; }
+
+private:
+    MemberFactory factory;
+    TrainingConfig<T> config;
+    std::vector<std::shared_ptr<Model<T>>> members;
+    std::vector<std::vector<int>> feature_subsets;   // vazio = todas as colunas
+    Eigen::MatrixX<T> stacked_weights;               // d x B, zero fora do subespaço do membro
+    std::vector<char> sign_outputs;                  // membro classificador: saída = sign(x^T w)
+    bool linear = false;
+
+    void executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y);
+    void trainMember(int b, const MatrixRef<T>& X, const VectorRef<T>& y, Eigen::MatrixX<T>& subspace_buffer);
+    Eigen::MatrixX<T> memberOutputs(const MatrixRef<T>& X) const;
+};
+
+#endif
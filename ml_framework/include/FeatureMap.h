@@ -0,0 +1,125 @@
+// include/FeatureMap.h
+#ifndef FEATURE_MAP_H
+#define FEATURE_MAP_H
+
+#include "Kernel.h"
+#include "RandomizedSVD.h"
+#include <Eigen/Dense>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+
+// Transformação de atributos aplicada em blocos de linhas, para que modelos
+// lineares consumam x -> z(x) sem materializar a matriz expandida n x D.
+template<typename T>
+class FeatureTransform {
+public:
+    virtual ~FeatureTransform() = default;
+
+    virtual void fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) = 0;
+
+    // out (rows(X_block) x outputDim) recebe z(x) de cada linha do bloco
+    virtual void transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                                Eigen::Ref<Eigen::MatrixX<T>> out) const = 0;
+
+    virtual int inputDim() const = 0;
+    virtual int outputDim() const = 0;
+
+    virtual void save(std::ostream& out) const = 0;
+    virtual void load(std::istream& in) = 0;
+
+    // Conveniência: transforma X inteira (materializa n x D)
+    Eigen::MatrixX<T> transform(const Eigen::Ref<const Eigen::MatrixX<T>>& X) const;
+
+    // Linhas por bloco para que um bloco de saída caiba em target_bytes (~L2)
+    int blockRows(std::size_t target_bytes = 256 * 1024) const;
+};
+
+// Random Fourier features (Rahimi & Recht) para o kernel RBF exp(-gamma |x - x'|²):
+//   z(x) = sqrt(2/D) cos(x W + b),  W ~ N(0, 2 gamma),  b ~ U(0, 2 pi)
+template<typename T>
+class RandomFourierFeatures : public FeatureTransform<T> {
+public:
+    RandomFourierFeatures(int num_features, T gamma, unsigned int seed = 42);
+
+    void fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) override;
+    void transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                        Eigen::Ref<Eigen::MatrixX<T>> out) const override;
+
+    int inputDim() const override { return static_cast<int>(W.rows()); }
+    int outputDim() const override { return num_features; }
+
+    void save(std::ostream& out) const override;
+    void load(std::istream& in) override;
+
+private:
+    int num_features;
+    T gamma;
+    unsigned int seed;
+    Eigen::MatrixX<T> W;        // d x D
+    Eigen::RowVectorX<T> b;     // 1 x D
+};
+
+// Aproximação de Nyström com m landmarks sorteados de X:
+//   z(x) = K(x, L) K_LL^{-1/2}
+template<typename T>
+class NystromFeatures : public FeatureTransform<T> {
+public:
+    NystromFeatures(const Kernel<T>& kernel, int num_landmarks, unsigned int seed = 42);
+
+    void fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) override;
+    void transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                        Eigen::Ref<Eigen::MatrixX<T>> out) const override;
+
+    int inputDim() const override { return static_cast<int>(landmarks.cols()); }
+    int outputDim() const override { return static_cast<int>(normalization.cols()); }
+
+    void save(std::ostream& out) const override;
+    void load(std::istream& in) override;
+
+private:
+    Kernel<T> kernel;
+    int num_landmarks;
+    unsigned int seed;
+    Eigen::MatrixX<T> landmarks;       // m x d
+    Eigen::MatrixX<T> normalization;   // m x m: K_LL^{-1/2}
+};
+
+// PCA por SVD truncada aleatorizada: z(x) = (x - mean) V_k, opcionalmente
+// branqueado (variância unitária por componente). fitFromSource ajusta em
+// fluxo a partir de um arquivo, sem carregar X inteira.
+template<typename T>
+class RandomizedPCA : public FeatureTransform<T> {
+public:
+    RandomizedPCA(int num_components, bool whiten = false, int power_iterations = 2,
+                  int oversampling = 10, unsigned int seed = 42);
+
+    void fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) override;
+    void fitFromSource(BatchSource<T>& source);
+    void transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                        Eigen::Ref<Eigen::MatrixX<T>> out) const override;
+
+    int inputDim() const override { return static_cast<int>(components.rows()); }
+    int outputDim() const override { return static_cast<int>(components.cols()); }
+
+    void save(std::ostream& out) const override;
+    void load(std::istream& in) override;
+
+    const Eigen::MatrixX<T>& getComponents() const { return components; }
+    const Eigen::RowVectorX<T>& getMean() const { return mean; }
+    const Eigen::VectorX<T>& getExplainedVariance() const { return explained_variance; }
+
+private:
+    int num_components;
+    bool whiten;
+    int power_iterations;
+    int oversampling;
+    unsigned int seed;
+    Eigen::RowVectorX<T> mean;            // 1 x d
+    Eigen::MatrixX<T> components;         // d x k
+    Eigen::VectorX<T> explained_variance; // S² / (n - 1)
+
+    void setFromSVD(const TruncatedSVD<T>& svd);
+};
+
+#endif
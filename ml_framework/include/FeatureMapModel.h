@@ -0,0 +1,43 @@
+// include/FeatureMapModel.h
+#ifndef FEATURE_MAP_MODEL_H
+#define FEATURE_MAP_MODEL_H
+
+#include "Model.h"
+#include "FeatureMap.h"
+#include <Eigen/Dense>
+#include <memory>
+
+// Modelo linear sobre atributos transformados z(x), gerados em blocos de
+// linhas do tamanho do cache:
+//  - LinearRegression (tipo exato): acumula Z^T Z e Z^T y bloco a bloco e
+//    resolve as equações normais (a matriz n x D nunca existe);
+//  - PocketPLA: varre os blocos atualizando os pesos (trainWithFeatureMap);
+//  - outros modelos, incluindo subclasses de LinearRegression: transforma X
+//    inteira e chama train (materializa).
+// predict também transforma em blocos. saveWeights grava os pesos do modelo
+// interno em filename e o mapa em filename + ".map".
+template<typename T>
+class FeatureMapModel : public Model<T> {
+public:
+    FeatureMapModel(std::shared_ptr<FeatureTransform<T>> map, std::shared_ptr<Model<T>> inner,
+                    bool fit_map = true);
+
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void saveWeights(const std::string& filename) const override;
+    void loadWeights(const std::string& filename) override;
+    Eigen::VectorX<T> getWeights() const override { return inner->getWeights(); }
+    void setWeights(const Eigen::VectorX<T>& new_weights) override { inner->setWeights(new_weights); }
+
+    FeatureTransform<T>& getFeatureMap() { return *map; }
+    Model<T>& getInnerModel() { return *inner; }
+
+private:
+    std::shared_ptr<FeatureTransform<T>> map;
+    std::shared_ptr<Model<T>> inner;
+    bool fit_map;
+
+    void executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y);
+};
+
+#endif
@@ -0,0 +1,70 @@
+// include/HashingVectorizer.h
+#ifndef HASHING_VECTORIZER_H
+#define HASHING_VECTORIZER_H
+
+#include <Eigen/Dense>
+#include <Eigen/Sparse>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Vetorizador de texto pelo "hashing trick": tokens e n-gramas são mapeados
+// por hash direto para um espaço fixo de 2^num_bits colunas, sem dicionário
+// (não há passada de construção de vocabulário nem memória para ele).
+// O sinal do hash (+1/-1) compensa colisões na média. Saída em CSR
+// (SparseMatrix RowMajor), consumível por PocketPLA e LRClassifier.
+//
+// Formato de arquivo: uma amostra por linha, "<rótulo> <texto...>",
+// ex.: "+1 ganhe dinheiro livre agora".
+template<typename T>
+class HashingVectorizer {
+public:
+    using SparseMatrix = Eigen::SparseMatrix<T, Eigen::RowMajor>;
+
+    // ngram_max em [1, 8]
+    explicit HashingVectorizer(int num_bits = 18, int ngram_max = 1, bool signed_hash = true,
+                               bool add_bias = true, bool l2_normalize = false);
+
+    // Número de colunas: 2^num_bits (+1 coluna constante de bias, se ativada)
+    int numFeatures() const { return hash_size + (add_bias ? 1 : 0); }
+
+    // Documentos em memória, vetorizados em paralelo por faixas de linhas
+    SparseMatrix transform(const std::vector<std::string>& documents, int num_threads = 0) const;
+
+    // Arquivo inteiro, dividido em faixas de bytes (alinhadas a linhas) por thread
+    void transformFile(const std::string& filename, SparseMatrix& X, Eigen::VectorX<T>& y,
+                       int num_threads = 0) const;
+
+    // Leitura em fluxo: entrega batches CSR de até batch_rows linhas ao consumidor
+    void streamFile(const std::string& filename, int batch_rows,
+                    const std::function<void(const SparseMatrix&, const Eigen::VectorX<T>&)>& consumer,
+                    int num_threads = 0) const;
+
+    // Tokens normalizados (minúsculas ASCII; bytes UTF-8 contam como letras)
+    static std::vector<std::string> tokenize(const std::string& text);
+
+private:
+    int num_bits;
+    int hash_size;
+    int ngram_max;
+    bool signed_hash;
+    bool add_bias;
+    bool l2_normalize;
+
+    // Linhas vetorizadas por uma thread antes da montagem do CSR final
+    struct RowBlock {
+        std::vector<int> row_sizes;
+        std::vector<int> indices;
+        std::vector<T> values;
+        std::vector<T> labels;
+    };
+
+    void vectorizeText(const char* begin, const char* end, RowBlock& block,
+                       std::vector<std::pair<int, T>>& scratch) const;
+    bool vectorizeLabeledLine(const std::string& line, RowBlock& block,
+                              std::vector<std::pair<int, T>>& scratch) const;
+    SparseMatrix assemble(const std::vector<RowBlock>& blocks) const;
+};
+
+#endif
@@ -0,0 +1,69 @@
+// include/KNN.h
+#ifndef KNN_H
+#define KNN_H
+
+#include "Model.h"
+#include "TrainingConfig.h"
+#include <Eigen/Dense>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// k vizinhos mais próximos por força bruta em blocos. As distâncias de um
+// bloco de consultas Q contra uma faixa de treino B saem de um GEMM:
+//   |q - b|² = |q|² + |b|² - 2 Q B^T
+// com faixas do tamanho do cache; cada consulta mantém um max-heap de k
+// vizinhos. Blocos de consultas são divididos entre threads. O conjunto de
+// treino pode ficar em 16 bits (half) ou 8 bits com escala por linha
+// (config.knn_storage); as faixas são convertidas para T antes do GEMM.
+template<typename T>
+class KNN : public Model<T> {
+public:
+    KNN();
+    explicit KNN(const TrainingConfig<T>& config);
+
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void saveWeights(const std::string& filename) const override;
+    void loadWeights(const std::string& filename) override;
+
+    // Não há pesos: expõe os rótulos do conjunto de treino
+    Eigen::VectorX<T> getWeights() const override { return labels; }
+    void setWeights(const Eigen::VectorX<T>& new_weights) override;
+
+    // Índices (n x k) e distâncias² (n x k) dos vizinhos, do mais próximo ao mais distante
+    void kneighbors(const MatrixRef<T>& X, Eigen::MatrixXi& indices, Eigen::MatrixX<T>& distances) const;
+
+    int getTrainingSize() const { return static_cast<int>(labels.size()); }
+    std::size_t getStorageBytes() const;
+    void setConfig(const TrainingConfig<T>& new_config) { config = new_config; }
+
+private:
+    using HalfMatrix = Eigen::Matrix<Eigen::half, Eigen::Dynamic, Eigen::Dynamic>;
+    using Int8Matrix = Eigen::Matrix<std::int8_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+    TrainingConfig<T> config;
+    KnnStorage storage = KnnStorage::Full;
+    Eigen::MatrixX<T> data_full;
+    HalfMatrix data_half;
+    Int8Matrix data_int8;
+    Eigen::VectorX<T> row_scales;      // escala por linha (Int8)
+    Eigen::VectorX<T> sq_norms;        // |b|² das linhas já no formato armazenado
+    Eigen::VectorX<T> labels;
+    int num_features = 0;
+
+    void executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y);
+    void computeNorms();
+    int trainingTileRows() const;
+
+    // Faixa [start, start + rows) do treino convertida para T em out.topRows(rows)
+    void decodeRows(int start, int rows, Eigen::MatrixX<T>& out) const;
+
+    // Max-heaps de k (distância², índice) por consulta, em best[i * k, (i + 1) * k);
+    // ao final cada faixa sai ordenada do mais próximo ao mais distante
+    void searchBlock(const MatrixRef<T>& queries, int k, std::pair<T, int>* best,
+                     Eigen::MatrixX<T>& tile, Eigen::MatrixX<T>& distances) const;
+    std::vector<std::pair<T, int>> searchAll(const MatrixRef<T>& X, int k) const;
+};
+
+#endif
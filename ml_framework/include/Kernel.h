@@ -0,0 +1,96 @@
+// include/Kernel.h
+#ifndef KERNEL_H
+#define KERNEL_H
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <list>
+#include <unordered_map>
+
+enum class KernelType { Linear, RBF, Polynomial };
+
+// Funções de kernel avaliadas em lote: K(A, B) = f(A B^T, |a|², |b|²), de modo
+// que o custo dominante é um GEMM/GEMV vetorizado pelo Eigen e a parte
+// não linear (exp/pow) é aplicada coeficiente a coeficiente.
+//  - Linear:     <a, b>
+//  - RBF:        exp(-gamma |a - b|²)
+//  - Polynomial: (gamma <a, b> + coef0)^degree
+template<typename T>
+class Kernel {
+public:
+    Kernel(KernelType type = KernelType::RBF, T gamma = 1, int degree = 3, T coef0 = 1);
+
+    static Kernel rbf(T gamma) { return Kernel(KernelType::RBF, gamma); }
+    static Kernel polynomial(int degree, T gamma = 1, T coef0 = 1) {
+        return Kernel(KernelType::Polynomial, gamma, degree, coef0);
+    }
+
+    // Matriz de kernel completa entre as linhas de A e de B (|A| x |B|)
+    Eigen::MatrixX<T> compute(const Eigen::Ref<const Eigen::MatrixX<T>>& A,
+                              const Eigen::Ref<const Eigen::MatrixX<T>>& B) const;
+
+    // Linha j de K(X, X) em out, com as normas² das linhas de X pré-calculadas
+    void computeRow(const Eigen::Ref<const Eigen::MatrixX<T>>& X, const Eigen::VectorX<T>& sq_norms,
+                    int j, Eigen::Ref<Eigen::VectorX<T>> out) const;
+
+    KernelType getType() const { return type; }
+    T getGamma() const { return gamma; }
+    int getDegree() const { return degree; }
+    T getCoef0() const { return coef0; }
+
+private:
+    KernelType type;
+    T gamma;
+    int degree;
+    T coef0;
+};
+
+// Cache LRU de linhas de kernel limitado em bytes. Evita materializar a matriz
+// de Gram n x n: só as linhas mais usadas recentemente ficam em memória, e os
+// vetores das linhas despejadas são reaproveitados para as novas.
+template<typename T>
+class KernelRowCache {
+public:
+    KernelRowCache(int row_length, std::size_t max_bytes);
+
+    // Linha em cache (marcada como mais recente) ou nullptr
+    const Eigen::VectorX<T>* find(int key);
+
+    // Reserva espaço para a linha key (despejando a menos recente se preciso);
+    // o chamador preenche o vetor devolvido
+    Eigen::VectorX<T>& insert(int key);
+
+    void clear();
+
+    // Primeira chave em cache (da mais recente para a menos recente) que
+    // satisfaz pred, ou -1; não altera a ordem LRU nem as estatísticas
+    template<typename Predicate>
+    int findKey(Predicate pred) const {
+        for (int key : lru) {
+            if (pred(key)) {
+                return key;
+            }
+        }
+        return -1;
+    }
+
+    int capacity() const { return max_rows; }
+    int size() const { return static_cast<int>(entries.size()); }
+    long getHits() const { return hits; }
+    long getMisses() const { return misses; }
+
+private:
+    struct Entry {
+        std::list<int>::iterator position;
+        Eigen::VectorX<T> row;
+    };
+
+    int row_length;
+    int max_rows;
+    std::list<int> lru;                       // frente = mais recente
+    std::unordered_map<int, Entry> entries;
+    long hits = 0;
+    long misses = 0;
+};
+
+#endif
@@ -0,0 +1,67 @@
+// include/KernelPerceptron.h
+#ifndef KERNEL_PERCEPTRON_H
+#define KERNEL_PERCEPTRON_H
+
+#include "Model.h"
+#include "TrainingConfig.h"
+#include "Metrics.h"
+#include "Kernel.h"
+#include <Eigen/Dense>
+#include <vector>
+
+// Perceptron pocket na forma dual: f(x) = sum_j alpha_j y_j (K(x_j, x) + 1).
+// Os valores de decisão f_i do conjunto de treino são mantidos
+// incrementalmente (cada atualização custa uma linha de kernel, O(n)), e as
+// linhas ficam num cache LRU limitado em bytes em vez da matriz de Gram n x n.
+// Com config.kernel_cache_first, o próximo ponto atualizado é um mal
+// classificado cuja linha já está em cache, e só na falta dele a varredura
+// circular segue: menos linhas calculadas e menos vetores de suporte, ao
+// custo de mais iterações O(n).
+// Após o treino só os vetores de suporte (alpha > 0) são guardados.
+template<typename T>
+class KernelPerceptron : public Model<T> {
+public:
+    explicit KernelPerceptron(const Kernel<T>& kernel = Kernel<T>());
+    KernelPerceptron(const Kernel<T>& kernel, const TrainingConfig<T>& config);
+
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void saveWeights(const std::string& filename) const override;
+    void loadWeights(const std::string& filename) override;
+
+    // Coeficientes duais alpha_j * y_j dos vetores de suporte
+    Eigen::VectorX<T> getWeights() const override { return coefficients; }
+    void setWeights(const Eigen::VectorX<T>& new_weights) override;
+
+    // Valores de decisão contínuos f(x)
+    Eigen::VectorX<T> decisionFunction(const MatrixRef<T>& X) const;
+
+    ClassificationMetrics<T> getTrainingMetrics() const { return training_metrics; }
+    void setConfig(const TrainingConfig<T>& new_config) { config = new_config; }
+
+    int getIterations() const { return iterations; }
+    T getFinalError() const { return final_error; }
+    int getSupportVectorCount() const { return static_cast<int>(support_vectors.rows()); }
+    const Eigen::MatrixX<T>& getSupportVectors() const { return support_vectors; }
+    T getBias() const { return bias; }
+    long getCacheHits() const { return cache_hits; }
+    long getCacheMisses() const { return cache_misses; }
+
+private:
+    Kernel<T> kernel;
+    TrainingConfig<T> config;
+    ClassificationMetrics<T> training_metrics;
+
+    Eigen::MatrixX<T> support_vectors;
+    Eigen::VectorX<T> coefficients;
+    T bias = 0;
+
+    int iterations = 0;
+    T final_error = 0;
+    long cache_hits = 0;
+    long cache_misses = 0;
+
+    void executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y);
+};
+
+#endif
@@ -13,10 +13,22 @@ public:
     explicit LRClassifier(const TrainingConfig<T>& config);
     
     // Sobrescreve train para adicionar métricas de classificação
-    void train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) override;
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
     
     // Sobrescreve predict para classificação binária
-    Eigen::VectorX<T> predict(const Eigen::MatrixX<T>& X) const override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const override;
+    
+    // Entrada row-major: ajuste da classe base + métricas de classificação
+    void trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predictRowMajor(const RowMajorRef<T>& X) const override;
+    
+    // Entrada esparsa (CSR): ajuste por CG da classe base + métricas de classificação
+    void trainSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X, const VectorRef<T>& y);
+    Eigen::VectorX<T> predictSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X) const override;
+    
+    // Métricas adiadas (MetricsMode::Skip): regressão + classificação numa chamada
+    void computeMetrics(const MatrixRef<T>& X, const VectorRef<T>& y) override;
     
     // Métodos específicos do classificador
     ClassificationMetrics<T> getClassificationMetrics() const { return classification_metrics; }
@@ -27,7 +39,7 @@ public:
 private:
     ClassificationMetrics<T> classification_metrics;
     
-    void calculateClassificationMetrics(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y);
+    void calculateClassificationMetrics(const MatrixRef<T>& X, const VectorRef<T>& y);
 };
 
 #endif
\ No newline at end of file
@@ -6,6 +6,7 @@
 #include "TrainingConfig.h"
 #include "Metrics.h"
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include <vector>
 
 template<typename T>
@@ -14,25 +15,81 @@ public:
     LinearRegression();
     explicit LinearRegression(const TrainingConfig<T>& config);
     
-    void train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) override;
-    Eigen::VectorX<T> predict(const Eigen::MatrixX<T>& X) const override;
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const override;
     void saveWeights(const std::string& filename) const override;
     void loadWeights(const std::string& filename) override;
     Eigen::VectorX<T> getWeights() const override { return weights; }
     void setWeights(const Eigen::VectorX<T>& new_weights) override { weights = new_weights; }
     
+    // Entrada row-major: mesma sequência de solvers e métricas do train
+    // (precisão mista -> direto -> SVD); X^T X e X^T y saem direto das linhas
+    // contíguas e só o fallback SVD copia para column-major (com
+    // pré-processamento, copia)
+    void trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predictRowMajor(const RowMajorRef<T>& X) const override;
+    
     T getRSquared() const { return r_squared; }
     T getMSE() const { return mse; }
+    bool hasMetrics() const { return metrics_computed; }
+    
+    // Ajuste a partir de estatísticas já acumuladas (ex.: blocos de atributos
+    // gerados em fluxo), sem acesso à matriz de dados. Sem X, as métricas saem
+    // das estatísticas; com T = float elas perdem precisão por cancelamento
+    // quando o ajuste é bom (use computeMetrics se houver os dados)
+    void trainFromNormalEquations(const MatrixRef<T>& gram, const VectorRef<T>& moment,
+                                  T y_squared_norm, T y_total, long num_samples);
+    
+    // Mínimos quadrados ponderados: min sum_i w_i (y_i - x_i^T w)². X^T W X é
+    // acumulada em blocos de linhas (sem copiar X) e resolvida por
+    // trainFromNormalEquations; as métricas de treino também são ponderadas
+    void trainWeighted(const MatrixRef<T>& X, const VectorRef<T>& y,
+                       const VectorRef<T>& sample_weights);
+    
+    // Entrada esparsa em CSR (ex.: HashingVectorizer com 2^k colunas): X^T X
+    // denso seria inviável, então resolve por gradiente conjugado sobre as
+    // equações normais, só com produtos X v e X^T v (custo O(nnz) por iteração).
+    // Usa max_iterations e tolerance do config; sem pré-processamento.
+    void trainSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X, const VectorRef<T>& y);
+    virtual Eigen::VectorX<T> predictSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X) const;
+    
+    // Calcula MSE e R² com uma passada sobre (X, y); útil com MetricsMode::Skip
+    virtual void computeMetrics(const MatrixRef<T>& X, const VectorRef<T>& y);
 
 protected:
     Eigen::VectorX<T> weights;
     TrainingConfig<T> config;
     T r_squared = 0;
     T mse = 0;
+    bool metrics_computed = false;
+    
+    // Estatísticas suficientes do último fit direto (equações normais)
+    Eigen::MatrixX<T> XTX;
+    Eigen::VectorX<T> XTy;
+    T yTy = 0;
+    T y_sum = 0;
+    long n_samples = 0;
+    bool has_sufficient_stats = false;
+    T cached_rss = 0;            // RSS exato do último fit, quando já conhecido
+    bool has_cached_rss = false;
+    Eigen::FullPivLU<Eigen::MatrixX<T>> lu;   // fatoração de X^T X, reaproveitada entre treinos
     
-    bool solveDirect(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y);
-    bool solveSVD(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y);
-    void calculateMetrics(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y);
+    // Templates sobre o layout de X (MatrixRef ou RowMajorRef), definidos no .cpp
+    template<typename Matrix>
+    bool solveDirect(const Matrix& X, const VectorRef<T>& y);
+    bool solveNormalEquations();
+    bool solveSVD(const MatrixRef<T>& X, const VectorRef<T>& y);
+    bool solveRandomizedSVD(const MatrixRef<T>& X, const VectorRef<T>& y);
+    template<typename Matrix>
+    bool solveMixedPrecision(const Matrix& X, const VectorRef<T>& y);
+    template<typename Matrix>
+    bool solve(const Matrix& X, const VectorRef<T>& y);
+    template<typename Matrix>
+    void calculateMetrics(const Matrix& X, const VectorRef<T>& y);
+    bool calculateMetricsFromSufficientStats();
+    template<typename Matrix>
+    void updateTrainingMetrics(const Matrix& X, const VectorRef<T>& y);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,89 @@
+// include/MLP.h
+#ifndef MLP_H
+#define MLP_H
+
+#include "Model.h"
+#include "MiniBatchPipeline.h"
+#include "TrainingConfig.h"
+#include <Eigen/Dense>
+#include <vector>
+
+enum class Activation { Identity, ReLU, Sigmoid, Tanh };
+
+// Perceptron multicamadas treinado por mini-batch (backprop + SGD/Adam).
+// layer_sizes inclui entrada e saída, ex.: {784, 128, 10}.
+//  - saída com 1 neurônio: regressão/classificação binária com perda MSE
+//    sobre output_activation (use Tanh para rótulos -1/+1);
+//  - saída com K > 1 neurônios: softmax + entropia cruzada, y contém o
+//    índice da classe (0..K-1) e predict devolve a classe prevista.
+// Amostras ficam nas linhas (batch x neurônios), então cada camada é um
+// GEMM A_out = A_in * W seguido de bias + ativação numa única passada.
+// A entrada de cada batch é lida direto do buffer do MiniBatchPipeline.
+template<typename T>
+class MLP : public Model<T> {
+public:
+    explicit MLP(const std::vector<int>& layer_sizes,
+                 Activation hidden_activation = Activation::ReLU,
+                 Activation output_activation = Activation::Identity);
+    MLP(const std::vector<int>& layer_sizes, const TrainingConfig<T>& config,
+        Activation hidden_activation = Activation::ReLU,
+        Activation output_activation = Activation::Identity);
+
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+
+    // Treina a partir de qualquer fonte de mini-batches (matriz ou arquivo em
+    // fluxo); os batches são preparados em segundo plano pelo MiniBatchPipeline
+    void trainFromSource(BatchSource<T>& source);
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void saveWeights(const std::string& filename) const override;
+    void loadWeights(const std::string& filename) override;
+
+    // Todos os parâmetros achatados: [W_1, b_1, W_2, b_2, ...] (coluna-major)
+    Eigen::VectorX<T> getWeights() const override;
+    void setWeights(const Eigen::VectorX<T>& new_weights) override;
+
+    // Saídas brutas da última camada (probabilidades no caso softmax)
+    Eigen::MatrixX<T> predictRaw(const MatrixRef<T>& X) const;
+
+    void setConfig(const TrainingConfig<T>& new_config) { config = new_config; }
+    const std::vector<int>& getLayerSizes() const { return layer_sizes; }
+    int getParameterCount() const;
+    const std::vector<T>& getLossHistory() const { return loss_history; }
+
+private:
+    std::vector<int> layer_sizes;
+    Activation hidden_activation;
+    Activation output_activation;
+    TrainingConfig<T> config;
+
+    std::vector<Eigen::MatrixX<T>> W;   // W[l]: entrada x saída
+    std::vector<Eigen::VectorX<T>> b;
+    std::vector<T> loss_history;
+
+    // Buffers pré-alocados por tamanho de batch (reutilizados entre batches)
+    int buffer_batch_size = 0;
+    std::vector<Eigen::MatrixX<T>> activations;   // activations[l] = saída da camada l
+    std::vector<Eigen::MatrixX<T>> deltas;
+    std::vector<Eigen::MatrixX<T>> grad_W;
+    std::vector<Eigen::VectorX<T>> grad_b;
+
+    // Momentos do Adam
+    std::vector<Eigen::MatrixX<T>> m_W, v_W;
+    std::vector<Eigen::VectorX<T>> m_b, v_b;
+    long adam_step = 0;
+
+    bool isSoftmaxOutput() const { return layer_sizes.back() > 1; }
+    int numLayers() const { return static_cast<int>(W.size()); }
+
+    void initializeWeights();
+    void allocateBuffers(int batch_size);
+    void resetOptimizerState();
+
+    using InputRef = Eigen::Ref<const Eigen::MatrixX<T>>;
+
+    void forward(const InputRef& input, std::vector<Eigen::MatrixX<T>>& acts) const;
+    T backward(const InputRef& input, const Eigen::Ref<const Eigen::VectorX<T>>& y_batch);
+    void optimizerStep();
+};
+
+#endif
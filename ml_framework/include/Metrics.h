@@ -20,10 +20,11 @@ template<typename T>
 class Metrics {
 public:
     static ClassificationMetrics<T> calculateClassificationMetrics(
-        const Eigen::VectorX<T>& y_true, 
-        const Eigen::VectorX<T>& y_pred);
+        const Eigen::Ref<const Eigen::VectorX<T>>& y_true, 
+        const Eigen::Ref<const Eigen::VectorX<T>>& y_pred);
     
-    static T calculateAccuracy(const Eigen::VectorX<T>& y_true, const Eigen::VectorX<T>& y_pred);
+    static T calculateAccuracy(const Eigen::Ref<const Eigen::VectorX<T>>& y_true,
+                               const Eigen::Ref<const Eigen::VectorX<T>>& y_pred);
 };
 
 #endif
\ No newline at end of file
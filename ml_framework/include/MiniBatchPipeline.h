@@ -0,0 +1,151 @@
+// include/MiniBatchPipeline.h
+#ifndef MINI_BATCH_PIPELINE_H
+#define MINI_BATCH_PIPELINE_H
+
+#include <Eigen/Dense>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Fonte de amostras para o pipeline de mini-batches.
+// beginEpoch é chamado antes de cada época (embaralhamento); fill copia até
+// max_rows amostras para as primeiras linhas dos buffers e retorna quantas
+// copiou (0 = fim da época).
+template<typename T>
+class BatchSource {
+public:
+    virtual ~BatchSource() = default;
+
+    virtual int numFeatures() const = 0;
+    virtual void beginEpoch(std::mt19937& rng, bool shuffle) = 0;
+    virtual int fill(Eigen::MatrixX<T>& X_buffer, Eigen::VectorX<T>& y_buffer, int max_rows) = 0;
+};
+
+// Matriz em memória: embaralha por permutação de índices, sem copiar X.
+// Guarda visões: X e y precisam viver enquanto a fonte for usada. Os membros
+// Ref são construídos direto da entrada, então quando ela exige cópia
+// (row-major, expressão) o temporário pertence ao próprio membro; por isso a
+// fonte não é copiável (a cópia de um Ref não leva o temporário junto).
+template<typename T>
+class MatrixBatchSource : public BatchSource<T> {
+public:
+    template<typename DerivedX, typename DerivedY>
+    MatrixBatchSource(const Eigen::MatrixBase<DerivedX>& X, const Eigen::MatrixBase<DerivedY>& y)
+        : X(X.derived()), y(y.derived()), permutation(X.rows()) {
+        initialize();
+    }
+    MatrixBatchSource(const MatrixBatchSource&) = delete;
+    MatrixBatchSource& operator=(const MatrixBatchSource&) = delete;
+
+    int numFeatures() const override { return static_cast<int>(X.cols()); }
+    void beginEpoch(std::mt19937& rng, bool shuffle) override;
+    int fill(Eigen::MatrixX<T>& X_buffer, Eigen::VectorX<T>& y_buffer, int max_rows) override;
+
+private:
+    Eigen::Ref<const Eigen::MatrixX<T>> X;
+    Eigen::Ref<const Eigen::VectorX<T>> y;
+    std::vector<int> permutation;
+    int cursor = 0;
+
+    void initialize();
+};
+
+// Arquivo delimitado lido em fluxo (ex.: train.csv dos dígitos).
+// O embaralhamento é local: blocos de shuffle_buffer_rows linhas são lidos,
+// embaralhados e servidos, então a memória fica limitada ao bloco.
+template<typename T>
+class CsvBatchSource : public BatchSource<T> {
+public:
+    CsvBatchSource(const std::string& filename, char delimiter = ';', int label_column = 0,
+                   bool has_header = true, int shuffle_buffer_rows = 8192, T feature_scale = 1);
+
+    int numFeatures() const override { return num_features; }
+    void beginEpoch(std::mt19937& rng, bool shuffle) override;
+    int fill(Eigen::MatrixX<T>& X_buffer, Eigen::VectorX<T>& y_buffer, int max_rows) override;
+
+private:
+    std::ifstream file;
+    std::string filename;
+    char delimiter;
+    int label_column;
+    bool has_header;
+    T feature_scale;
+    int num_features = 0;
+    std::streampos data_start;
+
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> block_X;
+    Eigen::VectorX<T> block_y;
+    std::vector<int> block_order;
+    int block_rows = 0;
+    int block_cursor = 0;
+    std::mt19937* rng = nullptr;
+    bool shuffle = true;
+    std::string line;
+
+    bool parseLine(const std::string& text, int row);
+    void readBlock();
+};
+
+// Pipeline com buffer duplo: uma thread em segundo plano reúne o próximo
+// mini-batch num buffer contíguo enquanto o modelo treina com o anterior.
+// Uso:
+//   pipeline.startEpoch();
+//   while (pipeline.next()) { treina com pipeline.batchX().topRows(pipeline.batchRows()) ... }
+template<typename T>
+class MiniBatchPipeline {
+public:
+    MiniBatchPipeline(BatchSource<T>& source, int batch_size, unsigned int seed = 42, bool shuffle = true);
+    ~MiniBatchPipeline();
+
+    MiniBatchPipeline(const MiniBatchPipeline&) = delete;
+    MiniBatchPipeline& operator=(const MiniBatchPipeline&) = delete;
+
+    // Inicia uma nova época (abandona o restante da época anterior, se houver)
+    void startEpoch();
+
+    // Libera o batch atual e espera o próximo; false ao fim da época
+    bool next();
+
+    const Eigen::MatrixX<T>& batchX() const { return buffers[current].X; }
+    const Eigen::VectorX<T>& batchY() const { return buffers[current].y; }
+    int batchRows() const { return buffers[current].rows; }
+    int batchSize() const { return batch_size; }
+    int numFeatures() const { return source.numFeatures(); }
+
+private:
+    enum class BufferState { Free, Ready, InUse };
+
+    struct Buffer {
+        Eigen::MatrixX<T> X;
+        Eigen::VectorX<T> y;
+        int rows = 0;
+        BufferState state = BufferState::Free;
+    };
+
+    BatchSource<T>& source;
+    int batch_size;
+    bool shuffle;
+    std::mt19937 rng;
+
+    Buffer buffers[2];
+    int current = -1;        // buffer em uso pelo consumidor
+    int consumer_next = 0;   // próximo buffer a ser consumido
+
+    std::thread worker;
+    std::mutex mutex;
+    std::condition_variable cv;
+    bool stop = false;
+    bool epoch_active = false;   // produtor deve produzir a época corrente
+    bool producer_idle = true;
+    bool abort_epoch = false;
+    std::exception_ptr worker_error;
+
+    void producerLoop();
+};
+
+#endif
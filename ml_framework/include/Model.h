@@ -2,32 +2,94 @@
 #ifndef MODEL_H
 #define MODEL_H
 
+#include "Workspace.h"
 #include <Eigen/Dense>
+#include <memory>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+// Visões sem cópia para as entradas dos modelos: MatrixX, Map sobre buffers
+// externos e blocos (.block(), .middleRows()) de matrizes column-major ligam
+// direto em MatrixRef; entradas row-major usam RowMajorRef.
+template<typename T>
+using MatrixRef = Eigen::Ref<const Eigen::MatrixX<T>>;
+template<typename T>
+using VectorRef = Eigen::Ref<const Eigen::VectorX<T>>;
+template<typename T>
+using RowMajorMatrixX = Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor>;
+template<typename T>
+using RowMajorRef = Eigen::Ref<const RowMajorMatrixX<T>>;
+
 template<typename T>
 class Model {
 public:
     virtual ~Model() = default;
-    
-    virtual void train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) = 0;
-    virtual Eigen::VectorX<T> predict(const Eigen::MatrixX<T>& X) const = 0;
+
+    virtual void train(const MatrixRef<T>& X, const VectorRef<T>& y) = 0;
+    virtual Eigen::VectorX<T> predict(const MatrixRef<T>& X) const = 0;
     virtual void saveWeights(const std::string& filename) const = 0;
     virtual void loadWeights(const std::string& filename) = 0;
     virtual Eigen::VectorX<T> getWeights() const = 0;
     virtual void setWeights(const Eigen::VectorX<T>& weights) = 0;
+
+    // Entrada row-major. Padrão: converte para column-major (uma cópia);
+    // modelos com kernel próprio para linhas contíguas sobrescrevem
+    virtual void trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) {
+        train(Eigen::MatrixX<T>(X), y);
+    }
+    virtual Eigen::VectorX<T> predictRowMajor(const RowMajorRef<T>& X) const {
+        return predict(Eigen::MatrixX<T>(X));
+    }
+
+    // Predição num buffer do chamador (out.size() == X.rows()). Padrão: copia o
+    // resultado de predict; modelos lineares sobrescrevem sem alocar
+    virtual void predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const {
+        if (out.size() != X.rows()) {
+            throw std::invalid_argument("Output size must match the number of rows of X");
+        }
+        out = predict(X);
+    }
     
+    // Front-end para qualquer expressão densa: escolhe a variante pelo layout
+    // em tempo de compilação, sem materializar uma cópia column-major
+    template<typename Derived>
+    void trainView(const Eigen::MatrixBase<Derived>& X, const VectorRef<T>& y) {
+        trainDispatch(X.derived(), y, std::integral_constant<bool, (Derived::Flags & Eigen::RowMajorBit) != 0>());
+    }
+    template<typename Derived>
+    Eigen::VectorX<T> predictView(const Eigen::MatrixBase<Derived>& X) const {
+        return predictDispatch(X.derived(), std::integral_constant<bool, (Derived::Flags & Eigen::RowMajorBit) != 0>());
+    }
+
     void setPreprocessing(bool enable) { preprocessing_enabled = enable; }
     bool getPreprocessing() const { return preprocessing_enabled; }
+    
+    // Arena para os temporários de treino, reaproveitada entre chamadas (e
+    // compartilhável entre modelos treinados na mesma thread). Sem ela, cada
+    // chamada usa uma arena própria e aloca como antes.
+    void setWorkspace(std::shared_ptr<Workspace> new_workspace) { workspace = std::move(new_workspace); }
+    const std::shared_ptr<Workspace>& getWorkspace() const { return workspace; }
 
 protected:
     bool preprocessing_enabled = false;
+    std::shared_ptr<Workspace> workspace;
     virtual void preprocessData(Eigen::MatrixX<T>& X, Eigen::VectorX<T>& y) {
         // Default: nenhum pré-processamento - remover parâmetros não usados
         (void)X; // Suprime warning
         (void)y; // Suprime warning
     }
+
+private:
+    template<typename Derived>
+    void trainDispatch(const Derived& X, const VectorRef<T>& y, std::true_type) { trainRowMajor(X, y); }
+    template<typename Derived>
+    void trainDispatch(const Derived& X, const VectorRef<T>& y, std::false_type) { train(X, y); }
+    template<typename Derived>
+    Eigen::VectorX<T> predictDispatch(const Derived& X, std::true_type) const { return predictRowMajor(X); }
+    template<typename Derived>
+    Eigen::VectorX<T> predictDispatch(const Derived& X, std::false_type) const { return predict(X); }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,58 @@
+// include/OnlineLinearRegression.h
+#ifndef ONLINE_LINEAR_REGRESSION_H
+#define ONLINE_LINEAR_REGRESSION_H
+
+#include "LinearRegression.h"
+#include <Eigen/Dense>
+#include <string>
+
+// Regressão linear online por mínimos quadrados recursivos (RLS).
+// Cada amostra nova custa O(d²) via atualização de posto 1 (Sherman–Morrison)
+// da inversa P = (X^T X)^-1, com fator de esquecimento opcional e janela
+// deslizante (downdate da amostra mais antiga).
+template<typename T>
+class OnlineLinearRegression : public LinearRegression<T> {
+public:
+    // Aceita linhas de matrizes coluna-major (X.row(i).transpose()) sem cópia
+    using SampleRef = Eigen::Ref<const Eigen::VectorX<T>, 0, Eigen::InnerStride<>>;
+
+    OnlineLinearRegression();
+    explicit OnlineLinearRegression(const TrainingConfig<T>& config);
+
+    // Reinicia o estado com P = rls_initial_variance * I e pesos nulos
+    void reset(int num_features);
+
+    // Incorpora uma nova observação (x, y) em O(d²)
+    void update(const SampleRef& x, T y);
+
+    // Treino em lote: reinicia e alimenta as linhas de X em ordem
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    // RLS processa amostra a amostra: sem atalho pelas equações normais
+    void trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) override { Model<T>::trainRowMajor(X, y); }
+
+    // Grava o estado RLS completo (pesos, P, janela e contagem), para que o
+    // modelo carregado continue aprendendo com update()
+    void saveWeights(const std::string& filename) const override;
+    void loadWeights(const std::string& filename) override;
+
+    long getSampleCount() const { return samples_seen; }
+    int getWindowCount() const { return window_count; }
+    // P completa (simétrica): internamente só o triângulo inferior é atualizado
+    Eigen::MatrixX<T> getInverseCovariance() const { return P.template selfadjointView<Eigen::Lower>(); }
+
+private:
+    Eigen::MatrixX<T> P;        // apenas o triângulo inferior é mantido
+    Eigen::VectorX<T> Px;       // buffer reutilizado para P * x
+
+    // Janela deslizante em buffer circular
+    Eigen::MatrixX<T> window_X;
+    Eigen::VectorX<T> window_y;
+    int window_head = 0;
+    int window_count = 0;
+    long samples_seen = 0;
+
+    bool removeOldest();
+    void rebuildFromWindow();
+};
+
+#endif
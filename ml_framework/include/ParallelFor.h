@@ -0,0 +1,73 @@
+// include/ParallelFor.h
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+#include <Eigen/Core>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+// Número de threads para count tarefas: num_threads > 0 é respeitado, 0 usa
+// hardware_concurrency; nunca passa de count
+inline int parallelThreads(int num_threads, int count) {
+    int threads = num_threads > 0 ? num_threads
+                                  : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    return std::max(1, std::min(threads, count));
+}
+
+// Fixa o número de threads do Eigen e restaura o anterior na saída (também
+// por exceção). O valor é global ao processo, então dentro de um parallelFor
+// o guard envolve o laço inteiro, na thread que o chama
+class EigenThreadsGuard {
+public:
+    explicit EigenThreadsGuard(int num_threads) : previous(Eigen::nbThreads()) {
+        Eigen::setNbThreads(num_threads);
+    }
+    ~EigenThreadsGuard() { Eigen::setNbThreads(previous); }
+    EigenThreadsGuard(const EigenThreadsGuard&) = delete;
+    EigenThreadsGuard& operator=(const EigenThreadsGuard&) = delete;
+
+private:
+    int previous;
+};
+
+// Executa body(i, t) para i em [0, count), com os índices distribuídos
+// dinamicamente entre threads threads; t identifica a thread (0 é a que
+// chamou), para indexar buffers por thread. Repassa a primeira exceção
+// depois que todas as threads terminam.
+template<typename Body>
+void parallelFor(int count, int threads, Body body) {
+    if (count <= 0) {
+        return;
+    }
+    threads = std::max(1, std::min(threads, count));
+    std::atomic<int> next(0);
+    std::vector<std::exception_ptr> errors(threads);
+    auto worker = [&](int t) {
+        try {
+            for (int i = next++; i < count; i = next++) {
+                body(i, t);
+            }
+        } catch (...) {
+            errors[t] = std::current_exception();
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; ++t) {
+        pool.emplace_back(worker, t);
+    }
+    worker(0);
+    for (std::thread& thread : pool) {
+        thread.join();
+    }
+    for (const std::exception_ptr& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+#endif
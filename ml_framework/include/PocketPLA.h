@@ -5,7 +5,9 @@
 #include "Model.h"
 #include "TrainingConfig.h"
 #include "Metrics.h"
+#include "FeatureMap.h"
 #include <Eigen/Dense>
+#include <Eigen/Sparse>
 #include <vector>
 
 template<typename T>
@@ -14,13 +16,36 @@ public:
     PocketPLA();
     explicit PocketPLA(const TrainingConfig<T>& config);
     
-    void train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) override;
-    Eigen::VectorX<T> predict(const Eigen::MatrixX<T>& X) const override;
+    void train(const MatrixRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predict(const MatrixRef<T>& X) const override;
+    void predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const override;
     void saveWeights(const std::string& filename) const override;
     void loadWeights(const std::string& filename) override;
     Eigen::VectorX<T> getWeights() const override { return weights; }
     void setWeights(const Eigen::VectorX<T>& new_weights) override { weights = new_weights; }
     
+    // Entrada row-major: cada atualização lê x_i contíguo em vez de um gather
+    // com passo n da matriz column-major (com pré-processamento, copia)
+    void trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) override;
+    Eigen::VectorX<T> predictRowMajor(const RowMajorRef<T>& X) const override;
+    
+    // Treina sobre z(x) gerado em blocos pelo mapa de atributos, sem materializar
+    // a matriz n x D. Cada época varre os blocos atualizando os pesos nos pontos
+    // mal classificados; o pocket é conferido com o erro exato ao fim da época.
+    // max_iterations limita o número total de atualizações. predict espera z(x).
+    void trainWithFeatureMap(const FeatureTransform<T>& map, const MatrixRef<T>& X, const VectorRef<T>& y);
+    
+    // Entrada esparsa em CSR (ex.: HashingVectorizer). Mesmo algoritmo do train
+    // denso, sem pré-processamento: padronizar destruiria a esparsidade.
+    void trainSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X, const VectorRef<T>& y);
+    Eigen::VectorX<T> predictSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X) const;
+    
+    // Pesos por amostra (ex.: multiplicidades do bootstrap no BaggingEnsemble),
+    // sem copiar X: só pontos com peso > 0 geram atualizações e o pocket
+    // compara o erro ponderado
+    void trainWeighted(const MatrixRef<T>& X, const VectorRef<T>& y,
+                       const VectorRef<T>& sample_weights);
+    
     ClassificationMetrics<T> getTrainingMetrics() const { return training_metrics; }
     void setConfig(const TrainingConfig<T>& new_config) { config = new_config; }
     
@@ -35,9 +60,24 @@ private:
     T final_error = 0;
     
     // ADICIONAR ESTA DECLARAÇÃO
-    void executeTraining(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y);
+    // Templates sobre o tipo da matriz (densa ou CSR), definidos no .cpp
+    template<typename Matrix>
+    void executeTraining(const Matrix& X, const VectorRef<T>& y,
+                         const VectorRef<T>* sample_weights = nullptr);
+    
+    // Multi-start: config.pla_restarts cadeias com sementes e pontos sorteados,
+    // em threads, avançando em rodadas até checkpoints fixos. Parada por
+    // tolerância e abandono são decididos entre rodadas, com empate pelo menor
+    // id de cadeia: mesma semente, mesmo resultado para qualquer num_threads
+    template<typename Matrix>
+    void executeMultiStart(const Matrix& X, const VectorRef<T>& y);
     
-    T calculateError(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) const;
+    // predictions: buffer de rascunho com y.size() posições
+    template<typename Matrix>
+    T calculateError(const Matrix& X, const VectorRef<T>& y, const VectorRef<T>* sample_weights,
+                     Eigen::Ref<Eigen::VectorX<T>> predictions) const;
+    T calculateMappedError(const FeatureTransform<T>& map, const MatrixRef<T>& X, const VectorRef<T>& y,
+                           Eigen::MatrixX<T>& Z_block, Eigen::VectorX<T>* predictions = nullptr) const;
     void initializeWeights(int num_features);
 };
 
@@ -0,0 +1,55 @@
+// include/RandomizedSVD.h
+#ifndef RANDOMIZED_SVD_H
+#define RANDOMIZED_SVD_H
+
+#include "MiniBatchPipeline.h"
+#include <Eigen/Dense>
+#include <functional>
+
+// SVD truncada de A (n x d): A_c ≈ U diag(S) V^T, com A_c = A - 1 mean se centrada
+template<typename T>
+struct TruncatedSVD {
+    Eigen::MatrixX<T> U;          // n x k, só preenchida por computeDirect
+    Eigen::MatrixX<T> V;          // d x k, vetores singulares à direita
+    Eigen::VectorX<T> S;          // k valores singulares, decrescentes
+    Eigen::RowVectorX<T> mean;    // média das linhas (zeros se não centrada)
+    long num_samples = 0;
+};
+
+// SVD truncada aleatorizada (Halko, Martinsson & Tropp) pela faixa de A^T A:
+//   Q = orth(Omega),  q vezes Q = orth(A^T A Q),  C = Q^T A^T A Q,
+//   C = W diag(S²) W^T  =>  V = Q W.
+// Cada produto A^T A Q é uma passada por blocos de linhas (G += A_b^T (A_b Q)),
+// então só matrizes d x l ficam em memória (l = rank + oversampling) e A pode
+// vir de um arquivo em fluxo. Total: power_iterations + 1 passadas sobre A.
+// Os GEMMs por bloco usam as threads do Eigen (OpenMP).
+template<typename T>
+class RandomizedSVD {
+public:
+    RandomizedSVD(int rank, int oversampling = 10, int power_iterations = 2, unsigned int seed = 42);
+
+    TruncatedSVD<T> compute(const Eigen::Ref<const Eigen::MatrixX<T>>& A, bool center,
+                            int block_rows = 2048) const;
+
+    // A lida de uma fonte (ex.: CsvBatchSource), sem embaralhar
+    TruncatedSVD<T> compute(BatchSource<T>& source, bool center, int block_rows = 2048) const;
+
+    // Range finder sobre o próprio A (não centrado): Q = orth(A Omega), q vezes
+    // Q = orth(A orth(A^T Q)), B = Q^T A = U_B S V^T, U = Q U_B. Guarda n x l em
+    // memória, mas não eleva o número de condição ao quadrado como A^T A:
+    // valores singulares pequenos são resolvidos como na JacobiSVD
+    TruncatedSVD<T> computeDirect(const Eigen::Ref<const Eigen::MatrixX<T>>& A) const;
+
+private:
+    using BlockVisitor = std::function<void(const Eigen::Ref<const Eigen::MatrixX<T>>&)>;
+    using Pass = std::function<void(const BlockVisitor&)>;
+
+    int rank;
+    int oversampling;
+    int power_iterations;
+    unsigned int seed;
+
+    TruncatedSVD<T> run(int d, bool center, const Pass& pass) const;
+};
+
+#endif
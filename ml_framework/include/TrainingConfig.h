@@ -2,14 +2,72 @@
 #ifndef TRAINING_CONFIG_H
 #define TRAINING_CONFIG_H
 
+enum class OptimizerType { SGD, Adam };
+
+// Armazenamento do conjunto de treino do KNN
+enum class KnnStorage {
+    Full,   // tipo T
+    Half,   // Eigen::half (16 bits)
+    Int8    // int8 com escala por linha (x ≈ escala * q)
+};
+
+// Como as métricas de treino (MSE, R², acurácia) são calculadas após o fit
+enum class MetricsMode {
+    Auto,       // estatísticas suficientes (X^T X, X^T y, y^T y) quando disponíveis e T = double; senão, passada nos dados
+    DataPass,   // sempre recalcula com uma passada extra sobre X
+    Skip        // não calcula no treino; use computeMetrics(X, y) depois se precisar
+};
+
 template<typename T>
 struct TrainingConfig {
     int max_iterations = 1000;
     T tolerance = static_cast<T>(1e-4);
     bool verbose = false;
+    MetricsMode metrics_mode = MetricsMode::Auto;
+    
+    // Parâmetros específicos da regressão linear
+    bool mixed_precision = false;    // fatora X^T X em float32 e refina em float64 (só T = double)
+    int refinement_steps = 10;       // máximo de passos de refinamento iterativo
+    bool randomized_svd = false;     // fallback SVD por RandomizedSVD em vez da JacobiSVD completa
+    int svd_rank = 0;                // posto alvo do fallback aleatorizado; 0 = número de colunas
+                                     // (decomposição completa: sem ganho sobre a JacobiSVD, use < d)
     
     // Parâmetros específicos do PLA Pocket
     int pocket_update_frequency = 10;
+    bool pla_random_selection = false;               // sorteia o ponto mal classificado em vez do primeiro
+    int pla_restarts = 1;                            // > 1: cadeias independentes em paralelo (multi-start)
+    T pla_abandon_margin = static_cast<T>(0.05);     // cadeia abandonada se o pocket fica essa fração acima
+                                                     // do melhor global (após 1/4 das iterações); 0 = nunca
+    
+    // Parâmetros específicos da regressão online (RLS)
+    T forgetting_factor = 1;                          // lambda em (0, 1]; 1 = sem esquecimento
+    T rls_initial_variance = static_cast<T>(1e6);     // P0 = rls_initial_variance * I
+    int window_size = 0;                              // 0 = sem janela deslizante
+    
+    // Parâmetros específicos do MLP (treino por mini-batch)
+    int epochs = 10;
+    int batch_size = 64;
+    T learning_rate = static_cast<T>(1e-3);
+    OptimizerType optimizer = OptimizerType::Adam;
+    T adam_beta1 = static_cast<T>(0.9);
+    T adam_beta2 = static_cast<T>(0.999);
+    T adam_epsilon = static_cast<T>(1e-8);
+    unsigned int seed = 42;
+    int num_threads = 0;                              // 0 = padrão do Eigen/OpenMP
+    
+    // Parâmetros específicos do perceptron kernelizado
+    long kernel_cache_bytes = 64L * 1024 * 1024;      // orçamento do cache LRU de linhas de kernel
+    bool kernel_cache_first = true;                   // atualiza primeiro pontos mal classificados já em cache
+    
+    // Parâmetros específicos do ensemble (BaggingEnsemble; usa também seed e num_threads)
+    int ensemble_size = 10;
+    bool bootstrap = true;                            // reamostragem com reposição via pesos por amostra
+    T feature_fraction = 1;                           // < 1: subespaço aleatório de colunas por membro
+    bool ensemble_vote = true;                        // voto majoritário; false = média das saídas
+    
+    // Parâmetros específicos do KNN (usa também num_threads)
+    int knn_k = 5;
+    KnnStorage knn_storage = KnnStorage::Full;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+// include/Workspace.h
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <Eigen/Dense>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Arena de memória de rascunho para temporários de treino e predição.
+// Os pedidos saem de um único bloco alinhado, em pilha (Scope marca e
+// devolve). Se um pedido não cabe, vem de um bloco extra; na próxima vez que
+// a arena é usada vazia, o bloco principal cresce até o pico observado, então
+// a partir da segunda chamada igual não há alocação no heap.
+// Não é thread-safe: use um Workspace por thread.
+class Workspace {
+public:
+    static const std::size_t ALIGNMENT = 64;
+
+    template<typename S>
+    using Vector = Eigen::Map<Eigen::VectorX<S>, Eigen::AlignedMax>;
+    template<typename S>
+    using Matrix = Eigen::Map<Eigen::MatrixX<S>, Eigen::AlignedMax>;
+
+    explicit Workspace(std::size_t initial_bytes = 0);
+    ~Workspace();
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    // Região de rascunho válida até o Scope que a pediu fechar. Sem Workspace
+    // (nullptr), o Scope usa uma arena própria que vive só durante a chamada.
+    class Scope;
+
+    std::size_t capacity() const { return buffer_size; }
+    std::size_t peakBytes() const { return peak; }
+    int growthCount() const { return growths; }
+
+private:
+    char* buffer = nullptr;
+    std::size_t buffer_size = 0;
+    std::size_t used = 0;        // bytes pedidos (inclui os blocos extras)
+    std::size_t peak = 0;
+    int growths = 0;
+    std::vector<std::pair<std::size_t, char*>> overflow;   // (offset, bloco extra)
+
+    void* allocate(std::size_t bytes);
+    void rewind(std::size_t mark);
+};
+
+class Workspace::Scope {
+public:
+    explicit Scope(Workspace* workspace)
+        : arena(workspace ? *workspace : fallback), mark(arena.used) {}
+    ~Scope() { arena.rewind(mark); }
+    Scope(const Scope&) = delete;
+    Scope& operator=(const Scope&) = delete;
+
+    template<typename S>
+    Vector<S> vector(Eigen::Index size) {
+        return Vector<S>(static_cast<S*>(arena.allocate(size * sizeof(S))), size);
+    }
+    template<typename S>
+    Matrix<S> matrix(Eigen::Index rows, Eigen::Index cols) {
+        return Matrix<S>(static_cast<S*>(arena.allocate(rows * cols * sizeof(S))), rows, cols);
+    }
+
+private:
+    Workspace fallback;
+    Workspace& arena;
+    std::size_t mark;
+};
+
+#endif
@@ -5,9 +5,52 @@
 #include "include/Metrics.h"
 #include "include/LinearRegression.h"
 #include "include/LRClassifier.h"
+#include "include/OnlineLinearRegression.h"
+#include "include/MLP.h"
+#include "include/MiniBatchPipeline.h"
+#include "include/KernelPerceptron.h"
+#include "include/FeatureMapModel.h"
+#include "include/HashingVectorizer.h"
+#include "include/BaggingEnsemble.h"
+#include "include/RandomizedSVD.h"
+#include "include/KNN.h"
+#include "include/Workspace.h"
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <thread>
 
 using namespace std;
 
+#if defined(__GLIBC__)
+// Contador de alocações: o malloc substituído vê todo pedido ao heap, inclusive
+// os temporários do Eigen, que não passam por operator new. Atômicos: threads
+// de fundo (pipeline, OpenMP) podem alocar enquanto a contagem está ligada
+extern "C" void* __libc_malloc(size_t size);
+static atomic<bool> count_allocations(false);
+static atomic<long> heap_allocations(0);
+
+extern "C" void* malloc(size_t size) noexcept {
+    if (count_allocations.load(memory_order_relaxed)) {
+        heap_allocations.fetch_add(1, memory_order_relaxed);
+    }
+    return __libc_malloc(size);
+}
+
+template<typename Body>
+long countAllocations(Body&& body) {
+    heap_allocations = 0;
+    count_allocations = true;
+    body();
+    count_allocations = false;
+    return heap_allocations.load();
+}
+#define ALLOCATION_COUNTER_AVAILABLE 1
+#endif
+
 
 
 
@@ -50,6 +93,43 @@ Eigen::MatrixXd generateXORData(Eigen::VectorXd& y, int samples = 100) {
     return X_with_bias;
 }
 
+// Carrega o CSV de dígitos (label;pixel0;...;pixel783), pixels normalizados em [0, 1]
+Eigen::MatrixXd loadDigitsCSV(const string& path, Eigen::VectorXd& y) {
+    ifstream file(path);
+    if (!file.is_open()) {
+        y.resize(0);
+        return Eigen::MatrixXd();
+    }
+    
+    vector<vector<double>> rows;
+    vector<double> labels;
+    string line;
+    getline(file, line); // cabeçalho
+    while (getline(file, line)) {
+        if (line.empty()) continue;
+        stringstream ss(line);
+        string cell;
+        getline(ss, cell, ';');
+        labels.push_back(stod(cell));
+        vector<double> pixels;
+        while (getline(ss, cell, ';')) {
+            pixels.push_back(stod(cell) / 255.0);
+        }
+        rows.push_back(pixels);
+    }
+    
+    Eigen::MatrixXd X(rows.size(), rows.empty() ? 0 : rows[0].size());
+    y.resize(labels.size());
+    for (size_t i = 0; i < rows.size(); ++i) {
+        X.row(i) = Eigen::Map<const Eigen::RowVectorXd>(rows[i].data(), rows[i].size());
+        y(i) = labels[i];
+    }
+    return X;
+}
+
+const string DIGITS_TRAIN_CSV = "../../Projetos/ProjetoDigitosMINST/train.csv";
+const string DIGITS_TEST_CSV = "../../Projetos/ProjetoDigitosMINST/test.csv";
+
 void testLinearSeparation() {
     cout << "=== TESTE 1: Dados Linearmente Separáveis ===" << endl;
     
@@ -266,6 +346,919 @@ void testLRClassifier() {
     cout << "PocketPLA Accuracy: " << pla_metrics.accuracy << endl;
 }
 
+void testOnlineLinearRegression() {
+    cout << "\n\n=== TESTE 7: Regressão Linear Online (RLS) ===" << endl;
+    
+    Eigen::VectorXd y;
+    Eigen::MatrixXd X = generateLinearData(y, 500);
+    y = y.array() + 0.1 * Eigen::VectorXd::Random(y.size()).array();
+    
+    // Lote vs. fluxo amostra a amostra
+    LinearRegression<double> batch;
+    batch.train(X, y);
+    
+    OnlineLinearRegression<double> online;
+    for (int i = 0; i < X.rows(); ++i) {
+        online.update(X.row(i).transpose(), y(i));
+    }
+    
+    double difference = (batch.getWeights() - online.getWeights()).norm();
+    cout << "Pesos lote:   [" << batch.getWeights().transpose() << "]" << endl;
+    cout << "Pesos online: [" << online.getWeights().transpose() << "]" << endl;
+    cout << "Diferença entre pesos: " << difference << " (deve ser ~0)" << endl;
+    
+    // P mantida só no triângulo inferior: o getter devolve a matriz simétrica completa
+    Eigen::MatrixXd P = online.getInverseCovariance();
+    Eigen::MatrixXd P_batch = (X.transpose() * X).inverse();
+    cout << "Assimetria de P: " << (P - P.transpose()).norm() << " (deve ser 0); diferença para (X^T X)^-1: "
+         << (P - P_batch).norm() / P_batch.norm() << " (deve ser ~0)" << endl;
+    
+    // Janela deslizante: deve coincidir com o lote das últimas W amostras
+    TrainingConfig<double> config;
+    config.window_size = 100;
+    OnlineLinearRegression<double> windowed(config);
+    windowed.train(X, y);
+    
+    LinearRegression<double> last_window;
+    last_window.train(X.bottomRows(100), y.tail(100));
+    double window_difference = (last_window.getWeights() - windowed.getWeights()).norm();
+    cout << "Diferença janela deslizante vs. lote (últimas 100): " << window_difference
+         << " (deve ser ~0)" << endl;
+    
+    // Salvar -> carregar -> update: o modelo carregado continua de onde parou
+    OnlineLinearRegression<double> saved(config);
+    saved.train(X.topRows(400), y.head(400));
+    saved.saveWeights("online_model.bin");
+    OnlineLinearRegression<double> resumed(config);
+    resumed.loadWeights("online_model.bin");
+    for (int i = 400; i < X.rows(); ++i) {
+        saved.update(X.row(i).transpose(), y(i));
+        resumed.update(X.row(i).transpose(), y(i));
+    }
+    cout << "Carregado + 100 updates - diferença de pesos: " << (saved.getWeights() - resumed.getWeights()).norm()
+         << " (deve ser 0), amostras: " << resumed.getSampleCount() << " (deve ser 500)" << endl;
+    
+    // Fator de esquecimento acompanha mudança de regime
+    config.window_size = 0;
+    config.forgetting_factor = 0.99;
+    OnlineLinearRegression<double> forgetting(config);
+    Eigen::VectorXd drifted_y = -y;
+    forgetting.train(X, y);
+    for (int i = 0; i < X.rows(); ++i) {
+        forgetting.update(X.row(i).transpose(), drifted_y(i));
+    }
+    cout << "Pesos após mudança de regime (lambda=0.99): ["
+         << forgetting.getWeights().transpose() << "] (devem ser ~ -pesos lote)" << endl;
+}
+
+void testMLP() {
+    cout << "\n\n=== TESTE 8: MLP (mini-batch + Adam) ===" << endl;
+    
+    // XOR: PocketPLA falha, o MLP deve separar
+    Eigen::VectorXd y_train, y_test;
+    Eigen::MatrixXd X_train = generateXORData(y_train, 400);
+    Eigen::MatrixXd X_test = generateXORData(y_test, 100);
+    
+    TrainingConfig<double> config;
+    config.epochs = 200;
+    config.batch_size = 32;
+    config.learning_rate = 0.01;
+    config.num_threads = 2;
+    
+    MLP<double> xor_model({3, 16, 1}, config, Activation::Tanh, Activation::Tanh);
+    // num_threads vale só durante o treino: o valor global do Eigen é restaurado
+    int eigen_threads = Eigen::nbThreads();
+    Eigen::setNbThreads(3);
+    xor_model.train(X_train, y_train);
+    cout << "Threads do Eigen depois do treino: " << Eigen::nbThreads() << " (deve ser 3)" << endl;
+    Eigen::setNbThreads(eigen_threads);
+    
+    Eigen::VectorXd xor_pred = xor_model.predict(X_test).array().sign();
+    cout << "XOR - perda final: " << xor_model.getLossHistory().back() << endl;
+    cout << "XOR - acurácia de teste: " << Metrics<double>::calculateAccuracy(y_test, xor_pred) << endl;
+    
+    // Persistência dos parâmetros achatados
+    xor_model.saveWeights("mlp_weights.bin");
+    MLP<double> loaded({3, 16, 1}, Activation::Tanh, Activation::Tanh);
+    loaded.loadWeights("mlp_weights.bin");
+    cout << "Diferença entre predições após carregar: "
+         << (xor_model.predict(X_test) - loaded.predict(X_test)).norm() << " (deve ser ~0)" << endl;
+    
+    // Dígitos (784 entradas, softmax sobre 10 classes)
+    Eigen::VectorXd digits_y, digits_y_test;
+    Eigen::MatrixXd digits_X = loadDigitsCSV(DIGITS_TRAIN_CSV, digits_y);
+    Eigen::MatrixXd digits_X_test = loadDigitsCSV(DIGITS_TEST_CSV, digits_y_test);
+    if (digits_X.rows() == 0 || digits_X_test.rows() == 0) {
+        cout << "Dígitos: arquivos CSV não encontrados, pulando." << endl;
+        return;
+    }
+    
+    TrainingConfig<float> digits_config;
+    digits_config.epochs = 5;
+    digits_config.batch_size = 64;
+    
+    MLP<float> digits_model({784, 128, 10}, digits_config);
+    auto start = chrono::steady_clock::now();
+    digits_model.train(digits_X.cast<float>(), digits_y.cast<float>());
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    Eigen::VectorXf digits_pred = digits_model.predict(digits_X_test.cast<float>());
+    cout << "Dígitos - " << digits_X.rows() << " amostras, " << digits_config.epochs
+         << " épocas em " << seconds << " s" << endl;
+    cout << "Dígitos - acurácia de teste: "
+         << Metrics<float>::calculateAccuracy(digits_y_test.cast<float>(), digits_pred) << endl;
+}
+
+void testMiniBatchPipeline() {
+    cout << "\n\n=== TESTE 9: Pipeline de Mini-Batches (buffer duplo) ===" << endl;
+    
+    // Cada época deve visitar todas as linhas exatamente uma vez
+    const int samples = 1000;
+    Eigen::MatrixXd X = Eigen::MatrixXd::Random(samples, 4);
+    Eigen::VectorXd ids = Eigen::VectorXd::LinSpaced(samples, 0, samples - 1);
+    
+    MatrixBatchSource<double> source(X, ids);
+    MiniBatchPipeline<double> pipeline(source, 64, 7);
+    
+    for (int epoch = 0; epoch < 3; ++epoch) {
+        vector<int> visits(samples, 0);
+        int batches = 0;
+        bool rows_match = true;
+        pipeline.startEpoch();
+        while (pipeline.next()) {
+            for (int r = 0; r < pipeline.batchRows(); ++r) {
+                int id = static_cast<int>(pipeline.batchY()(r));
+                visits[id]++;
+                rows_match = rows_match && pipeline.batchX().row(r) == X.row(id);
+            }
+            batches++;
+        }
+        bool all_once = true;
+        for (int v : visits) all_once = all_once && v == 1;
+        cout << "Época " << epoch + 1 << ": " << batches << " batches, cada linha uma vez: "
+             << (all_once ? "sim" : "não") << ", linhas corretas: " << (rows_match ? "sim" : "não") << endl;
+    }
+    
+    // Época abandonada no meio e reiniciada
+    pipeline.startEpoch();
+    pipeline.next();
+    pipeline.startEpoch();
+    int restarted = 0;
+    while (pipeline.next()) restarted += pipeline.batchRows();
+    cout << "Amostras após reiniciar época abandonada: " << restarted << " (deve ser " << samples << ")" << endl;
+    
+    // MLP treinado direto do CSV em fluxo
+    try {
+        CsvBatchSource<float> csv(DIGITS_TRAIN_CSV, ';', 0, true, 1024, 1.0f / 255.0f);
+        TrainingConfig<float> config;
+        config.epochs = 5;
+        
+        MLP<float> model({784, 128, 10}, config);
+        auto start = chrono::steady_clock::now();
+        model.trainFromSource(csv);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        
+        Eigen::VectorXd digits_y_test;
+        Eigen::MatrixXd digits_X_test = loadDigitsCSV(DIGITS_TEST_CSV, digits_y_test);
+        Eigen::VectorXf pred = model.predict(digits_X_test.cast<float>());
+        cout << "MLP via CSV em fluxo: " << config.epochs << " épocas em " << seconds << " s, acurácia de teste: "
+             << Metrics<float>::calculateAccuracy(digits_y_test.cast<float>(), pred) << endl;
+    } catch (const runtime_error& e) {
+        cout << "Dígitos: " << e.what() << ", pulando." << endl;
+    }
+}
+
+void testMetricsModes() {
+    cout << "\n\n=== TESTE 10: Métricas por Estatísticas Suficientes ===" << endl;
+    
+    Eigen::VectorXd y;
+    Eigen::MatrixXd X = generateLinearData(y, 2000);
+    y = y.array() + 0.1 * Eigen::VectorXd::Random(y.size()).array();
+    
+    TrainingConfig<double> config;
+    config.metrics_mode = MetricsMode::DataPass;
+    LinearRegression<double> data_pass(config);
+    data_pass.train(X, y);
+    
+    config.metrics_mode = MetricsMode::Auto;
+    LinearRegression<double> sufficient(config);
+    sufficient.train(X, y);
+    
+    cout << "Passada nos dados   - R²: " << data_pass.getRSquared() << ", MSE: " << data_pass.getMSE() << endl;
+    cout << "Estat. suficientes  - R²: " << sufficient.getRSquared() << ", MSE: " << sufficient.getMSE() << endl;
+    cout << "Diferença MSE: " << abs(data_pass.getMSE() - sufficient.getMSE()) << " (deve ser ~0)" << endl;
+    
+    // Em float, Auto faz a passada nos dados: y^T y - 2 w^T X^T y + w^T X^T X w cancelaria
+    Eigen::MatrixXf Xf = X.cast<float>();
+    Eigen::VectorXf yf = (X * Eigen::Vector3d(0.5, 2.0, 1.0) + 0.001 * Eigen::VectorXd::Random(y.size())).cast<float>();
+    TrainingConfig<float> float_config;
+    float_config.metrics_mode = MetricsMode::DataPass;
+    LinearRegression<float> float_data_pass(float_config);
+    float_data_pass.train(Xf, yf);
+    float_config.metrics_mode = MetricsMode::Auto;
+    LinearRegression<float> float_auto(float_config);
+    float_auto.train(Xf, yf);
+    cout << "float, ruído 0.001 - MSE Auto: " << float_auto.getMSE() << ", passada nos dados: "
+         << float_data_pass.getMSE() << " (devem coincidir)" << endl;
+    
+    // Métricas adiadas
+    config.metrics_mode = MetricsMode::Skip;
+    LRClassifier<double> deferred(config);
+    deferred.train(X, y.array().sign().matrix());
+    cout << "Skip - métricas calculadas no treino: " << (deferred.hasMetrics() ? "sim" : "não") << endl;
+    deferred.computeMetrics(X, y.array().sign().matrix());
+    cout << "Após computeMetrics - R²: " << deferred.getRSquared()
+         << ", acurácia: " << deferred.getClassificationMetrics().accuracy << endl;
+}
+
+void testMixedPrecision() {
+    cout << "\n\n=== TESTE 11: Mínimos Quadrados em Precisão Mista ===" << endl;
+    
+    // Problema alto e moderadamente mal condicionado (colunas em escalas diferentes)
+    const int samples = 20000, features = 64;
+    Eigen::MatrixXd X = Eigen::MatrixXd::Random(samples, features);
+    for (int j = 0; j < features; ++j) {
+        X.col(j) *= pow(10.0, -2.0 * j / features);
+    }
+    Eigen::VectorXd true_weights = Eigen::VectorXd::LinSpaced(features, -1, 1);
+    Eigen::VectorXd y = X * true_weights + 0.01 * Eigen::VectorXd::Random(samples);
+    
+    TrainingConfig<double> config;
+    LinearRegression<double> reference(config);
+    auto start = chrono::steady_clock::now();
+    reference.train(X, y);
+    double double_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    config.mixed_precision = true;
+    LinearRegression<double> mixed(config);
+    start = chrono::steady_clock::now();
+    mixed.train(X, y);
+    double mixed_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    LinearRegression<float> single;
+    single.train(X.cast<float>(), y.cast<float>());
+    
+    double norm = reference.getWeights().norm();
+    cout << "Erro relativo float32 puro: "
+         << (single.getWeights().cast<double>() - reference.getWeights()).norm() / norm << endl;
+    cout << "Erro relativo precisão mista: "
+         << (mixed.getWeights() - reference.getWeights()).norm() / norm << " (deve ser ~1e-15)" << endl;
+    cout << "MSE float64: " << reference.getMSE() << ", MSE mista: " << mixed.getMSE() << endl;
+    cout << "Tempo float64: " << double_seconds << " s, precisão mista: " << mixed_seconds << " s" << endl;
+    
+    // Dados colineares: o fator float é rejeitado e cai no caminho float64/SVD
+    Eigen::MatrixXd X_singular = X;
+    X_singular.col(1) = X_singular.col(2);
+    LinearRegression<double> collinear(config);
+    collinear.train(X_singular, y);
+    cout << "Colinear com precisão mista - MSE: " << collinear.getMSE() << endl;
+}
+
+void testKernelPerceptron() {
+    cout << "\n\n=== TESTE 12: Perceptron Kernelizado (XOR) ===" << endl;
+    
+    Eigen::VectorXd y_train, y_test;
+    Eigen::MatrixXd X_train = generateXORData(y_train, 200);
+    Eigen::MatrixXd X_test = generateXORData(y_test, 50);
+    
+    TrainingConfig<double> config;
+    config.max_iterations = 1000;
+    config.verbose = true;
+    
+    KernelPerceptron<double> rbf(Kernel<double>::rbf(2.0), config);
+    rbf.train(X_train, y_train);
+    cout << "RBF - acurácia de teste: " << Metrics<double>::calculateAccuracy(y_test, rbf.predict(X_test)) << endl;
+    
+    KernelPerceptron<double> poly(Kernel<double>::polynomial(2), config);
+    poly.train(X_train, y_train);
+    cout << "Polinomial (grau 2) - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, poly.predict(X_test)) << endl;
+    
+    PocketPLA<double> linear(config);
+    linear.train(X_train, y_train);
+    cout << "PocketPLA linear - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, linear.predict(X_test)) << endl;
+    
+    // Persistência dos vetores de suporte
+    rbf.saveWeights("kernel_pla_weights.bin");
+    KernelPerceptron<double> loaded;
+    loaded.loadWeights("kernel_pla_weights.bin");
+    cout << "Diferença entre decisões após carregar: "
+         << (rbf.decisionFunction(X_test) - loaded.decisionFunction(X_test)).norm() << " (deve ser ~0)" << endl;
+    
+    // Muitos pontos com cache pequeno: memória limitada, sem Gram n x n.
+    // Só a varredura circular despeja cada linha antes de voltar a ela; com
+    // prioridade ao cache as linhas são reaproveitadas
+    Eigen::VectorXd y_large;
+    Eigen::MatrixXd X_large = generateXORData(y_large, 20000);
+    config.verbose = false;
+    config.max_iterations = 50000;
+    config.tolerance = 0.005;
+    config.kernel_cache_bytes = 16L * 1024 * 1024;   // ~100 linhas de 20000 doubles
+    for (int cache_first = 0; cache_first < 2; ++cache_first) {
+        config.kernel_cache_first = cache_first;
+        KernelPerceptron<double> large(Kernel<double>::rbf(2.0), config);
+        auto start = chrono::steady_clock::now();
+        large.train(X_large, y_large);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "20000 pontos, " << (cache_first ? "prioridade ao cache" : "só varredura") << ": erro "
+             << large.getFinalError() << ", " << large.getIterations() << " iterações, "
+             << large.getSupportVectorCount() << " vetores de suporte, cache " << large.getCacheHits() << "/"
+             << large.getCacheMisses() << " (acertos/faltas), " << seconds << " s" << endl;
+    }
+}
+
+void testFeatureMaps() {
+    cout << "\n\n=== TESTE 13: Random Fourier / Nyström + Modelos Lineares (XOR) ===" << endl;
+    
+    Eigen::VectorXd y_train, y_test;
+    Eigen::MatrixXd X_train = generateXORData(y_train, 2000);
+    Eigen::MatrixXd X_test = generateXORData(y_test, 500);
+    
+    TrainingConfig<double> config;
+    
+    // Regressão linear sobre RFF: Gram acumulada em blocos, sem a matriz n x D
+    auto rff = make_shared<RandomFourierFeatures<double>>(300, 2.0);
+    FeatureMapModel<double> rff_regression(rff, make_shared<LinearRegression<double>>(config));
+    rff_regression.train(X_train, y_train);
+    Eigen::VectorXd rff_pred = rff_regression.predict(X_test).array().sign();
+    cout << "RFF (D=300) + LinearRegression - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, rff_pred) << endl;
+    
+    // Subclasses de LinearRegression passam pelo próprio train (estado RLS, métricas)
+    auto rff_classifier = make_shared<LRClassifier<double>>();
+    FeatureMapModel<double> rff_lr(rff, rff_classifier, false);
+    rff_lr.train(X_train, y_train);
+    auto rff_online = make_shared<OnlineLinearRegression<double>>();
+    FeatureMapModel<double> rff_rls(rff, rff_online, false);
+    rff_rls.train(X_train, y_train);
+    cout << "RFF + LRClassifier - acurácia de treino (métricas próprias): "
+         << rff_classifier->getClassificationMetrics().accuracy << "; RFF + RLS - amostras vistas: "
+         << rff_online->getSampleCount() << " (deve ser 2000)" << endl;
+    
+    // PocketPLA sobre RFF
+    config.max_iterations = 2000;
+    FeatureMapModel<double> rff_pla(make_shared<RandomFourierFeatures<double>>(300, 2.0),
+                                    make_shared<PocketPLA<double>>(config));
+    rff_pla.train(X_train, y_train);
+    cout << "RFF (D=300) + PocketPLA - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, rff_pla.predict(X_test)) << endl;
+    
+    // Nyström com 100 landmarks
+    auto nystrom = make_shared<NystromFeatures<double>>(Kernel<double>::rbf(2.0), 100);
+    FeatureMapModel<double> nystrom_regression(nystrom, make_shared<LinearRegression<double>>());
+    nystrom_regression.train(X_train, y_train);
+    Eigen::VectorXd nystrom_pred = nystrom_regression.predict(X_test).array().sign();
+    cout << "Nyström (m=100) + LinearRegression - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, nystrom_pred) << endl;
+    
+    // Persistência: pesos + mapa
+    nystrom_regression.saveWeights("nystrom_weights.bin");
+    FeatureMapModel<double> loaded(make_shared<NystromFeatures<double>>(Kernel<double>::rbf(1.0), 1),
+                                   make_shared<LinearRegression<double>>(), false);
+    loaded.loadWeights("nystrom_weights.bin");
+    cout << "Diferença entre predições após carregar: "
+         << (nystrom_regression.predict(X_test) - loaded.predict(X_test)).norm() << " (deve ser ~0)" << endl;
+}
+
+// Gera um arquivo "<rótulo> <texto>" com mensagens sintéticas de spam (+1) e
+// não-spam (-1); data/spam.txt da prática já traz contagens, não texto bruto
+void writeSyntheticTextFile(const string& filename, int samples) {
+    const vector<string> spam = {"Ganhe", "grátis", "dinheiro", "oferta", "clique", "prêmio", "FREE", "winner"};
+    const vector<string> ham = {"reunião", "projeto", "relatório", "amanhã", "equipe", "aula", "meeting", "notes"};
+    const vector<string> common = {"o", "a", "de", "para", "você", "hoje", "agora", "com"};
+    mt19937 rng(7);
+    uniform_int_distribution<int> pick(0, 7);
+    uniform_real_distribution<double> noise(0.0, 1.0);
+    
+    ofstream file(filename);
+    for (int i = 0; i < samples; ++i) {
+        bool is_spam = (i % 2 == 0);
+        const vector<string>& own = is_spam ? spam : ham;
+        const vector<string>& other = is_spam ? ham : spam;
+        file << (is_spam ? "+1" : "-1");
+        for (int w = 0; w < 8; ++w) {
+            double r = noise(rng);
+            const vector<string>& source = r < 0.45 ? own : (r < 0.9 ? common : other);
+            file << (w % 3 == 0 ? ", " : " ") << source[pick(rng)];
+        }
+        file << "\n";
+    }
+}
+
+void testFeatureHashing() {
+    cout << "\n\n=== TESTE 14: Hashing de Atributos de Texto + Modelos Esparsos ===" << endl;
+    
+    vector<string> tokens = HashingVectorizer<double>::tokenize("Ganhe DINHEIRO, já: clique-aqui!");
+    cout << "Tokens:";
+    for (const string& token : tokens) {
+        cout << " [" << token << "]";
+    }
+    cout << endl;
+    
+    try {
+        HashingVectorizer<double> too_long(12, 9);
+        cout << "ngram_max = 9 aceito (não deveria)" << endl;
+    } catch (const invalid_argument& e) {
+        cout << "ngram_max = 9 rejeitado: " << e.what() << endl;
+    }
+    
+    const string filename = "spam_texto.txt";
+    writeSyntheticTextFile(filename, 4000);
+    
+    // Unigramas + bigramas em 2^12 colunas com sinal, lidos por 4 threads
+    HashingVectorizer<double> vectorizer(12, 2);
+    HashingVectorizer<double>::SparseMatrix X;
+    Eigen::VectorXd y;
+    auto start = chrono::steady_clock::now();
+    vectorizer.transformFile(filename, X, y, 4);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Arquivo: " << X.rows() << " linhas, " << X.cols() << " colunas, "
+         << X.nonZeros() << " não nulos, " << seconds << " s" << endl;
+    
+    // Leitura em fluxo deve produzir as mesmas linhas em batches
+    int batches = 0;
+    long streamed_rows = 0;
+    long streamed_nnz = 0;
+    vectorizer.streamFile(filename, 512, [&](const HashingVectorizer<double>::SparseMatrix& X_batch,
+                                             const Eigen::VectorXd& y_batch) {
+        ++batches;
+        streamed_rows += X_batch.rows();
+        streamed_nnz += X_batch.nonZeros();
+        (void)y_batch;
+    }, 2);
+    cout << "Fluxo: " << batches << " batches, " << streamed_rows << " linhas, " << streamed_nnz
+         << " não nulos (deve coincidir)" << endl;
+    
+    HashingVectorizer<double>::SparseMatrix X_train = X.topRows(3000);
+    HashingVectorizer<double>::SparseMatrix X_test = X.bottomRows(1000);
+    Eigen::VectorXd y_train = y.head(3000);
+    Eigen::VectorXd y_test = y.tail(1000);
+    
+    TrainingConfig<double> config;
+    config.max_iterations = 500;
+    PocketPLA<double> pla(config);
+    pla.trainSparse(X_train, y_train);
+    cout << "PocketPLA esparso - erro de treino: " << pla.getFinalError() << ", acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, pla.predictSparse(X_test)) << endl;
+    
+    LRClassifier<double> classifier(config);
+    classifier.trainSparse(X_train, y_train);
+    cout << "LRClassifier esparso - acurácia de treino: " << classifier.getClassificationMetrics().accuracy
+         << ", acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, classifier.predictSparse(X_test)) << endl;
+}
+
+// Dados lineares em d dimensões (+ bias) com fração de rótulos trocados
+Eigen::MatrixXd generateNoisyLinearData(Eigen::VectorXd& y, int samples, int dims, double flip, unsigned seed) {
+    mt19937 rng(seed);
+    normal_distribution<double> normal(0.0, 1.0);
+    uniform_real_distribution<double> uniform(0.0, 1.0);
+    Eigen::VectorXd w_true(dims + 1);
+    mt19937 w_rng(1);
+    for (int j = 0; j <= dims; ++j) {
+        w_true(j) = normal(w_rng);
+    }
+    
+    Eigen::MatrixXd X = Eigen::MatrixXd::Ones(samples, dims + 1);
+    y.resize(samples);
+    for (int i = 0; i < samples; ++i) {
+        for (int j = 1; j <= dims; ++j) {
+            X(i, j) = normal(rng);
+        }
+        y(i) = X.row(i).dot(w_true) > 0 ? 1 : -1;
+        if (uniform(rng) < flip) {
+            y(i) = -y(i);
+        }
+    }
+    return X;
+}
+
+void testBaggingEnsemble() {
+    cout << "\n\n=== TESTE 15: Bagging Paralelo (PocketPLA / LRClassifier) ===" << endl;
+    
+    Eigen::VectorXd y_train, y_test;
+    Eigen::MatrixXd X_train = generateNoisyLinearData(y_train, 2000, 10, 0.15, 3);
+    Eigen::MatrixXd X_test = generateNoisyLinearData(y_test, 2000, 10, 0.0, 4);
+    
+    TrainingConfig<double> config;
+    config.max_iterations = 300;
+    
+    PocketPLA<double> single(config);
+    single.train(X_train, y_train);
+    cout << "PocketPLA único - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, single.predict(X_test)) << endl;
+    
+    // Bootstrap por pesos: nenhum membro copia X
+    config.ensemble_size = 25;
+    config.num_threads = 4;
+    BaggingEnsemble<double> bagged([config]() { return make_shared<PocketPLA<double>>(config); }, config);
+    auto start = chrono::steady_clock::now();
+    bagged.train(X_train, y_train);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Bagging de 25 PocketPLA - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, bagged.predict(X_test))
+         << ", pesos empilhados " << bagged.getStackedWeights().rows() << "x"
+         << bagged.getStackedWeights().cols() << ", " << seconds << " s" << endl;
+    
+    // Subespaços aleatórios com LRClassifier, agregando pela média
+    TrainingConfig<double> subspace_config = config;
+    subspace_config.bootstrap = false;
+    subspace_config.feature_fraction = 0.6;
+    subspace_config.ensemble_vote = false;
+    BaggingEnsemble<double> subspace([]() { return make_shared<LRClassifier<double>>(); }, subspace_config);
+    subspace.train(X_train, y_train);
+    Eigen::VectorXd subspace_pred = subspace.predict(X_test).array().sign();
+    cout << "Subespaços (60% das colunas) + LRClassifier - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, subspace_pred) << endl;
+    
+    // Persistência da forma empilhada
+    bagged.saveWeights("bagging_weights.bin");
+    BaggingEnsemble<double> loaded([]() { return make_shared<PocketPLA<double>>(); }, config);
+    loaded.loadWeights("bagging_weights.bin");
+    cout << "Diferença entre predições após carregar: "
+         << (bagged.predict(X_test) - loaded.predict(X_test)).norm() << " (deve ser 0)" << endl;
+}
+
+void testMultiStartPocketPLA() {
+    cout << "\n\n=== TESTE 16: PocketPLA Multi-start Paralelo ===" << endl;
+    
+    Eigen::VectorXd y_train, y_test;
+    Eigen::MatrixXd X_train = generateNoisyLinearData(y_train, 2000, 10, 0.15, 5);
+    Eigen::MatrixXd X_test = generateNoisyLinearData(y_test, 2000, 10, 0.0, 6);
+    
+    TrainingConfig<double> config;
+    config.max_iterations = 400;
+    
+    PocketPLA<double> single(config);
+    single.train(X_train, y_train);
+    cout << "Cadeia única (primeiro erro) - erro de treino: " << single.getFinalError()
+         << ", acurácia de teste: " << Metrics<double>::calculateAccuracy(y_test, single.predict(X_test)) << endl;
+    
+    config.pla_random_selection = true;
+    PocketPLA<double> random_single(config);
+    random_single.train(X_train, y_train);
+    cout << "Cadeia única (ponto sorteado) - erro de treino: " << random_single.getFinalError()
+         << ", acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_test, random_single.predict(X_test)) << endl;
+    
+    // 8 cadeias; as que ficam 5% acima do melhor pocket global são abandonadas
+    config.pla_restarts = 8;
+    config.num_threads = 4;
+    PocketPLA<double> multi(config);
+    auto start = chrono::steady_clock::now();
+    multi.train(X_train, y_train);
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "Multi-start (8 cadeias) - erro de treino: " << multi.getFinalError()
+         << ", acurácia de teste: " << Metrics<double>::calculateAccuracy(y_test, multi.predict(X_test))
+         << ", iterações totais: " << multi.getIterations() << ", " << seconds << " s" << endl;
+    
+    // Reprodutível: mesma semente, mesmo pocket e iterações com 1 ou 3 threads
+    TrainingConfig<double> sequential_config = config;
+    sequential_config.num_threads = 1;
+    TrainingConfig<double> three_config = config;
+    three_config.num_threads = 3;
+    PocketPLA<double> sequential(sequential_config);
+    PocketPLA<double> three(three_config);
+    sequential.train(X_train, y_train);
+    three.train(X_train, y_train);
+    cout << "1 x 4 x 3 threads - diferença de pesos: " << (sequential.getWeights() - multi.getWeights()).norm()
+         << " / " << (three.getWeights() - multi.getWeights()).norm() << ", iterações: "
+         << sequential.getIterations() << " / " << multi.getIterations() << " / " << three.getIterations()
+         << " (devem coincidir)" << endl;
+    
+    // Dados separáveis: a primeira cadeia com erro zero encerra as demais
+    Eigen::VectorXd y_separable;
+    Eigen::MatrixXd X_separable = generateNoisyLinearData(y_separable, 500, 3, 0.0, 7);
+    config.max_iterations = 20000;
+    PocketPLA<double> separable(config);
+    separable.train(X_separable, y_separable);
+    cout << "Separável (8 cadeias) - erro de treino: " << separable.getFinalError()
+         << ", iterações totais: " << separable.getIterations() << " (bem abaixo de 8 x 20000)" << endl;
+    
+    // Sem iterações: cada cadeia publica o pocket inicial
+    config.max_iterations = 0;
+    PocketPLA<double> no_iterations(config);
+    no_iterations.train(X_train, y_train);
+    cout << "max_iterations = 0 - erro de treino: " << no_iterations.getFinalError()
+         << ", pesos: " << no_iterations.getWeights().size() << " (deve ser " << X_train.cols() << ")" << endl;
+}
+
+void testRefViews() {
+    cout << "\n\n=== TESTE 17: API sem Cópia (Map / Bloco / Row-major) ===" << endl;
+    
+    Eigen::VectorXd y;
+    Eigen::MatrixXd X = generateNoisyLinearData(y, 4000, 20, 0.05, 8);
+    const int n = static_cast<int>(X.rows());
+    const int d = static_cast<int>(X.cols());
+    
+    // Buffers externos: um column-major e um row-major com os mesmos dados
+    vector<double> col_buffer(X.data(), X.data() + X.size());
+    vector<double> row_buffer(X.size());
+    Eigen::Map<RowMajorMatrixX<double>>(row_buffer.data(), n, d) = X;
+    Eigen::Map<const Eigen::MatrixXd> X_col(col_buffer.data(), n, d);
+    Eigen::Map<const RowMajorMatrixX<double>> X_row(row_buffer.data(), n, d);
+    
+    MatrixRef<double> view(X_col);
+    cout << "Map column-major liga sem cópia: " << (view.data() == col_buffer.data() ? "sim" : "não") << endl;
+    MatrixRef<double> block_view(X.topRows(1000));
+    cout << "Bloco liga sem cópia: " << (block_view.data() == X.data() ? "sim" : "não") << endl;
+    
+    TrainingConfig<double> config;
+    config.max_iterations = 500;
+    PocketPLA<double> pla_col(config);
+    PocketPLA<double> pla_row(config);
+    
+    auto start = chrono::steady_clock::now();
+    pla_col.trainView(X_col, y);
+    double col_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    start = chrono::steady_clock::now();
+    pla_row.trainView(X_row, y);
+    double row_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "PocketPLA column-major: " << col_seconds << " s, row-major: " << row_seconds << " s, "
+         << "diferença de pesos: " << (pla_col.getWeights() - pla_row.getWeights()).norm() << endl;
+    cout << "Predições iguais nos dois layouts: "
+         << ((pla_col.predictView(X_col) - pla_row.predictView(X_row)).norm() == 0 ? "sim" : "não") << endl;
+    
+    LinearRegression<double> regression_col;
+    LinearRegression<double> regression_row;
+    regression_col.trainView(X_col, y);
+    regression_row.trainView(X_row, y);
+    cout << "LinearRegression - diferença de pesos entre layouts: "
+         << (regression_col.getWeights() - regression_row.getWeights()).norm() << " (deve ser ~0)" << endl;
+    
+    // Row-major segue a mesma sequência de solvers: precisão mista e fallback SVD
+    TrainingConfig<double> mixed_config;
+    mixed_config.mixed_precision = true;
+    LinearRegression<double> mixed_col(mixed_config);
+    LinearRegression<double> mixed_row(mixed_config);
+    mixed_col.trainView(X_col, y);
+    mixed_row.trainView(X_row, y);
+    Eigen::MatrixXd X_collinear(n, d + 1);
+    X_collinear << X, X.col(1);
+    RowMajorMatrixX<double> X_collinear_row = X_collinear;
+    LinearRegression<double> collinear_col;
+    LinearRegression<double> collinear_row;
+    collinear_col.train(X_collinear, y);
+    collinear_row.trainView(X_collinear_row, y);
+    cout << "Row-major vs column-major - precisão mista: "
+         << (mixed_col.getWeights() - mixed_row.getWeights()).norm() << ", colinear (SVD): "
+         << (collinear_col.getWeights() - collinear_row.getWeights()).norm() << " (devem ser ~0)" << endl;
+    
+    // Fonte de mini-batches sobre matriz row-major: o membro Ref guarda a cópia
+    Eigen::VectorXd row_labels = Eigen::VectorXd::LinSpaced(n, 0, n - 1);
+    MatrixBatchSource<double> row_source(RowMajorMatrixX<double>(X.topRows(n)), row_labels);
+    mt19937 source_rng(1);
+    row_source.beginEpoch(source_rng, false);
+    Eigen::MatrixXd X_batch(64, d);
+    Eigen::VectorXd y_batch(64);
+    row_source.fill(X_batch, y_batch, 64);
+    cout << "MatrixBatchSource com entrada row-major temporária - diferença: "
+         << (X_batch - X.topRows(64)).norm() << " (deve ser 0)" << endl;
+    
+    // Bloco de uma matriz maior passado direto ao modelo
+    LRClassifier<double> classifier;
+    classifier.train(X.topRows(3000), y.head(3000));
+    cout << "LRClassifier em X.topRows(3000) - acurácia nas 1000 restantes: "
+         << Metrics<double>::calculateAccuracy(y.tail(1000), classifier.predict(X.bottomRows(1000))) << endl;
+}
+
+// Linhas com rótulo a (+1) ou b (-1), como na prática "1 contra 5"
+Eigen::MatrixXd selectDigitPair(const Eigen::MatrixXd& X, const Eigen::VectorXd& labels, int a, int b,
+                                Eigen::VectorXd& y) {
+    vector<int> rows;
+    for (int i = 0; i < labels.size(); ++i) {
+        if (labels(i) == a || labels(i) == b) {
+            rows.push_back(i);
+        }
+    }
+    y.resize(rows.size());
+    for (size_t k = 0; k < rows.size(); ++k) {
+        y(k) = labels(rows[k]) == a ? 1 : -1;
+    }
+    return X(rows, Eigen::all);
+}
+
+void testRandomizedPCA() {
+    cout << "\n\n=== TESTE 18: PCA / SVD Truncada Aleatorizada ===" << endl;
+    
+    // Fallback de posto deficiente: coluna duplicada força a passagem pelo SVD
+    // (sintético, roda mesmo sem os CSVs dos dígitos)
+    Eigen::VectorXd y_rank;
+    Eigen::MatrixXd X_rank(500, 6);
+    X_rank.leftCols(5) = generateNoisyLinearData(y_rank, 500, 4, 0.0, 9);
+    X_rank.col(5) = X_rank.col(1);
+    LinearRegression<double> jacobi;
+    jacobi.train(X_rank, y_rank);
+    TrainingConfig<double> randomized_config;
+    randomized_config.randomized_svd = true;
+    LinearRegression<double> randomized(randomized_config);
+    randomized.train(X_rank, y_rank);
+    cout << "Posto deficiente - diferença de pesos JacobiSVD x aleatorizada: "
+         << (jacobi.getWeights() - randomized.getWeights()).norm() << " (deve ser ~0)" << endl;
+    
+    // Coluna em escala 1e-9 (cond(X) ~1e9): por X^T X ela cairia abaixo do corte
+    // sqrt(eps) S_max; o range finder sobre X a resolve como a JacobiSVD
+    Eigen::MatrixXd X_ill = X_rank;
+    X_ill.col(4) *= 1e-9;
+    Eigen::VectorXd y_ill = X_rank.leftCols(5) * Eigen::VectorXd::LinSpaced(5, 1, 2);
+    LinearRegression<double> jacobi_ill;
+    LinearRegression<double> randomized_ill(randomized_config);
+    jacobi_ill.train(X_ill, y_ill);
+    randomized_ill.train(X_ill, y_ill);
+    cout << "Mal condicionado - diferença relativa de pesos JacobiSVD x aleatorizada: "
+         << (jacobi_ill.getWeights() - randomized_ill.getWeights()).norm() / jacobi_ill.getWeights().norm()
+         << " (deve ser ~0)" << endl;
+    
+    Eigen::VectorXd labels, labels_test;
+    Eigen::MatrixXd X = loadDigitsCSV(DIGITS_TRAIN_CSV, labels);
+    Eigen::MatrixXd X_test = loadDigitsCSV(DIGITS_TEST_CSV, labels_test);
+    if (X.rows() == 0 || X_test.rows() == 0) {
+        cout << "Dígitos: arquivos CSV não encontrados, pulando." << endl;
+        return;
+    }
+    
+    // 784 pixels -> 50 componentes
+    RandomizedPCA<double> pca(50);
+    auto start = chrono::steady_clock::now();
+    pca.fit(X);
+    double pca_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    
+    // Referência exata: autodecomposição da covariância 784 x 784
+    start = chrono::steady_clock::now();
+    Eigen::MatrixXd centered = X.rowwise() - X.colwise().mean();
+    Eigen::MatrixXd covariance = centered.transpose() * centered / static_cast<double>(X.rows() - 1);
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> exact(covariance);
+    double exact_seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    Eigen::VectorXd exact_top = exact.eigenvalues().reverse().head(50);
+    
+    cout << "PCA aleatorizada (50 comp.): " << pca_seconds << " s; autodecomposição exata: "
+         << exact_seconds << " s" << endl;
+    cout << "Variância explicada: " << pca.getExplainedVariance().sum() / covariance.trace()
+         << " do total; erro relativo dos 10 primeiros autovalores: "
+         << (pca.getExplainedVariance().head(10) - exact_top.head(10)).norm() / exact_top.head(10).norm() << endl;
+    
+    // Mesmo ajuste lendo o CSV em fluxo
+    CsvBatchSource<double> csv(DIGITS_TRAIN_CSV, ';', 0, true, 1024, 1.0 / 255.0);
+    RandomizedPCA<double> streamed(50);
+    streamed.fitFromSource(csv);
+    cout << "Ajuste em fluxo - diferença na variância explicada: "
+         << (streamed.getExplainedVariance() - pca.getExplainedVariance()).norm() /
+            pca.getExplainedVariance().norm() << endl;
+    
+    // 1 contra 5: PCA como transformação persistida junto do classificador
+    Eigen::VectorXd y_pair, y_pair_test;
+    Eigen::MatrixXd X_pair = selectDigitPair(X, labels, 1, 5, y_pair);
+    Eigen::MatrixXd X_pair_test = selectDigitPair(X_test, labels_test, 1, 5, y_pair_test);
+    FeatureMapModel<double> model(make_shared<RandomizedPCA<double>>(50), make_shared<LRClassifier<double>>());
+    model.train(X_pair, y_pair);
+    Eigen::VectorXd pair_pred = model.predict(X_pair_test).array().sign();
+    cout << "PCA(50) + LRClassifier, 1 contra 5 - acurácia de teste: "
+         << Metrics<double>::calculateAccuracy(y_pair_test, pair_pred) << endl;
+    
+    model.saveWeights("pca_model.bin");
+    FeatureMapModel<double> loaded(make_shared<RandomizedPCA<double>>(1), make_shared<LRClassifier<double>>(), false);
+    loaded.loadWeights("pca_model.bin");
+    cout << "Diferença entre predições após carregar: "
+         << (model.predict(X_pair_test) - loaded.predict(X_pair_test)).norm() << " (deve ser 0)" << endl;
+}
+
+void testKNN() {
+    cout << "\n\n=== TESTE 19: KNN por Blocos (GEMM) ===" << endl;
+    
+    Eigen::VectorXd labels, labels_test;
+    Eigen::MatrixXd X = loadDigitsCSV(DIGITS_TRAIN_CSV, labels);
+    Eigen::MatrixXd X_test = loadDigitsCSV(DIGITS_TEST_CSV, labels_test);
+    if (X.rows() == 0 || X_test.rows() == 0) {
+        cout << "Dígitos: arquivos CSV não encontrados, pulando." << endl;
+        return;
+    }
+    Eigen::MatrixXf Xf = X.cast<float>();
+    Eigen::MatrixXf Xf_test = X_test.cast<float>();
+    Eigen::VectorXf yf = labels.cast<float>();
+    Eigen::VectorXf yf_test = labels_test.cast<float>();
+    
+    // Referência ingênua: vizinho mais próximo das 50 primeiras consultas
+    TrainingConfig<float> config;
+    config.knn_k = 1;
+    KNN<float> nearest(config);
+    nearest.train(Xf, yf);
+    Eigen::MatrixXi indices;
+    Eigen::MatrixXf distances;
+    nearest.kneighbors(Xf_test.topRows(50), indices, distances);
+    int mismatches = 0;
+    for (int i = 0; i < 50; ++i) {
+        Eigen::Index reference;
+        (Xf.rowwise() - Xf_test.row(i)).rowwise().squaredNorm().minCoeff(&reference);
+        if (reference != indices(i, 0)) mismatches++;
+    }
+    cout << "Vizinho mais próximo diferente da busca ingênua: " << mismatches << " de 50" << endl;
+    
+    const char* names[] = {"float32", "float16", "int8"};
+    const KnnStorage storages[] = {KnnStorage::Full, KnnStorage::Half, KnnStorage::Int8};
+    for (int s = 0; s < 3; ++s) {
+        config.knn_k = 3;
+        config.knn_storage = storages[s];
+        KNN<float> knn(config);
+        knn.train(Xf, yf);
+        auto start = chrono::steady_clock::now();
+        Eigen::VectorXf pred = knn.predict(Xf_test);
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        cout << "k=3, " << names[s] << " (" << knn.getStorageBytes() / 1024 << " KB) - acurácia: "
+             << Metrics<float>::calculateAccuracy(yf_test, pred) << ", predict: " << seconds << " s" << endl;
+        
+        if (storages[s] == KnnStorage::Int8) {
+            knn.saveWeights("knn_model.bin");
+            KNN<float> loaded(config);
+            loaded.loadWeights("knn_model.bin");
+            cout << "Predições diferentes após carregar: "
+                 << (loaded.predict(Xf_test) - pred).cwiseAbs().count() << " (deve ser 0)" << endl;
+        }
+    }
+    
+    // Uma thread externa (GEMM com as threads do Eigen) x padrão (blocos entre
+    // threads, GEMM sequencial em cada uma)
+    config.knn_storage = KnnStorage::Full;
+    Eigen::VectorXf thread_pred[2];
+    double thread_seconds[2];
+    for (int run = 0; run < 2; ++run) {
+        config.num_threads = run == 0 ? 1 : 0;
+        KNN<float> knn(config);
+        knn.train(Xf, yf);
+        auto start = chrono::steady_clock::now();
+        thread_pred[run] = knn.predict(Xf_test);
+        thread_seconds[run] = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+    cout << "predict com num_threads = 1: " << thread_seconds[0] << " s; padrão ("
+         << thread::hardware_concurrency() << " núcleos): " << thread_seconds[1] << " s; predições diferentes: "
+         << (thread_pred[0] - thread_pred[1]).cwiseAbs().count() << " (deve ser 0)" << endl;
+}
+
+void testWorkspace() {
+    cout << "\n\n=== TESTE 20: Workspace (Arena) sem Alocações no Treino ===" << endl;
+    
+#ifndef ALLOCATION_COUNTER_AVAILABLE
+    cout << "Contador de alocações indisponível (requer glibc), pulando." << endl;
+#else
+    // GEMM paralelo do Eigen aloca os próprios buffers de empacotamento
+    int eigen_threads = Eigen::nbThreads();
+    Eigen::setNbThreads(1);
+    
+    Eigen::VectorXd y;
+    Eigen::MatrixXd X = generateNoisyLinearData(y, 2000, 10, 0.05, 17);
+    Eigen::VectorXd out(X.rows());
+    const int rounds = 5;
+    
+    TrainingConfig<double> pla_config;
+    pla_config.max_iterations = 200;
+    pla_config.pla_random_selection = true;
+    TrainingConfig<double> regression_config;
+    regression_config.metrics_mode = MetricsMode::DataPass;
+    
+    Eigen::VectorXd pla_weights[2];
+    for (int with_workspace = 0; with_workspace < 2; ++with_workspace) {
+        shared_ptr<Workspace> workspace = with_workspace ? make_shared<Workspace>() : nullptr;
+        PocketPLA<double> pla(pla_config);
+        LinearRegression<double> regression(regression_config);
+        LRClassifier<double> classifier;
+        pla.setWorkspace(workspace);
+        regression.setWorkspace(workspace);
+        classifier.setWorkspace(workspace);
+        
+        auto round = [&]() {
+            pla.train(X, y);
+            pla.predictInto(X, out);
+            regression.train(X, y);
+            regression.predictInto(X, out);
+            classifier.train(X, y);
+            classifier.predictInto(X, out);
+        };
+        round();   // aquecimento: a arena cresce até o pico
+        
+        auto start = chrono::steady_clock::now();
+        long allocations = countAllocations([&]() {
+            for (int r = 0; r < rounds; ++r) {
+                round();
+            }
+        });
+        double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        pla_weights[with_workspace] = pla.getWeights();
+        
+        cout << (with_workspace ? "Com workspace: " : "Sem workspace: ") << allocations << " alocações em "
+             << rounds << " rodadas de treino + predição (" << seconds << " s)"
+             << (with_workspace ? " (deve ser 0)" : "") << endl;
+        if (with_workspace) {
+            cout << "Arena: " << workspace->capacity() / 1024 << " KB, cresceu "
+                 << workspace->growthCount() << " vez(es)" << endl;
+        }
+    }
+    cout << "Diferença entre os pesos do PLA com e sem workspace: "
+         << (pla_weights[0] - pla_weights[1]).norm() << " (deve ser 0)" << endl;
+    
+    Eigen::setNbThreads(eigen_threads);
+#endif
+}
+
 int main() {
     try {
         cout << "Framework de Machine Learning - Teste PocketPLA" << endl;
@@ -277,6 +1270,20 @@ int main() {
         testDifferentConfigurations();
         testLinearRegression();
         testLRClassifier();
+        testOnlineLinearRegression();
+        testMLP();
+        testMiniBatchPipeline();
+        testMetricsModes();
+        testMixedPrecision();
+        testKernelPerceptron();
+        testFeatureMaps();
+        testFeatureHashing();
+        testBaggingEnsemble();
+        testMultiStartPocketPLA();
+        testRefViews();
+        testRandomizedPCA();
+        testKNN();
+        testWorkspace();
         
         cout << "\n\nTodos os testes completados!" << endl;
         
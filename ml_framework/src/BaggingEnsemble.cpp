@@ -0,0 +1,279 @@
+// src/BaggingEnsemble.cpp
+#include "../include/BaggingEnsemble.h"
+#include "../include/LRClassifier.h"
+#include "../include/OnlineLinearRegression.h"
+#include "../include/ParallelFor.h"
+#include "../include/PocketPLA.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+template<typename T>
+BaggingEnsemble<T>::BaggingEnsemble(MemberFactory factory, const TrainingConfig<T>& config)
+    : factory(std::move(factory)), config(config) {
+    if (!this->factory) {
+        throw std::invalid_argument("BaggingEnsemble needs a member factory");
+    }
+}
+
+template<typename T>
+void BaggingEnsemble<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+
+    if (this->preprocessing_enabled) {
+        Eigen::MatrixX<T> X_processed = X;
+        Eigen::VectorX<T> y_processed = y;
+        this->preprocessData(X_processed, y_processed);
+        executeTraining(X_processed, y_processed);
+    } else {
+        executeTraining(X, y);
+    }
+}
+
+template<typename T>
+void BaggingEnsemble<T>::executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    const int B = config.ensemble_size;
+    if (B <= 0) {
+        throw std::invalid_argument("ensemble_size must be positive");
+    }
+    if (X.rows() == 0) {
+        throw std::invalid_argument("Cannot train an ensemble on an empty matrix");
+    }
+
+    members.assign(B, nullptr);
+    feature_subsets.assign(B, std::vector<int>());
+
+    // Membros distribuídos dinamicamente entre as threads; cada membro tem
+    // seu próprio gerador (seed + b), então o resultado não depende do número de threads
+    const int threads = parallelThreads(config.num_threads, B);
+    std::vector<Eigen::MatrixX<T>> subspace_buffers(threads);   // reaproveitado pelos membros de cada thread
+    {
+        // Membros em paralelo: GEMM/LU de cada um sequencial, sem empilhar as
+        // threads do Eigen sobre as do ensemble
+        EigenThreadsGuard eigen_threads(threads > 1 ? 1 : Eigen::nbThreads());
+        parallelFor(B, threads, [&](int b, int t) {
+            trainMember(b, X, y, subspace_buffers[t]);
+        });
+    }
+
+    // Empilha os pesos quando todo membro é linear (predict = x^T w ou sign(x^T w))
+    linear = true;
+    sign_outputs.assign(B, 0);
+    for (int b = 0; b < B; ++b) {
+        Model<T>* member = members[b].get();
+        bool is_classifier = dynamic_cast<PocketPLA<T>*>(member) || dynamic_cast<LRClassifier<T>*>(member);
+        bool is_regression = dynamic_cast<LinearRegression<T>*>(member) != nullptr;
+        if (!is_classifier && !is_regression) {
+            linear = false;
+            break;
+        }
+        sign_outputs[b] = is_classifier ? 1 : 0;
+    }
+
+    if (linear) {
+        stacked_weights = Eigen::MatrixX<T>::Zero(X.cols(), B);
+        for (int b = 0; b < B; ++b) {
+            Eigen::VectorX<T> w = members[b]->getWeights();
+            if (feature_subsets[b].empty()) {
+                stacked_weights.col(b) = w;
+            } else {
+                for (std::size_t k = 0; k < feature_subsets[b].size(); ++k) {
+                    stacked_weights(feature_subsets[b][k], b) = w(k);
+                }
+            }
+        }
+    } else {
+        stacked_weights.resize(0, 0);
+    }
+
+    if (config.verbose) {
+        std::cout << "Bagging ensemble training completed: " << B << " members, "
+                  << threads << " threads, " << (linear ? "stacked linear scoring" : "per-member scoring")
+                  << std::endl;
+    }
+}
+
+template<typename T>
+void BaggingEnsemble<T>::trainMember(int b, const MatrixRef<T>& X, const VectorRef<T>& y,
+                                     Eigen::MatrixX<T>& subspace_buffer) {
+    const int n = static_cast<int>(X.rows());
+    const int d = static_cast<int>(X.cols());
+    std::mt19937 rng(config.seed + static_cast<unsigned int>(b));
+
+    // Bootstrap como multiplicidades: n sorteios com reposição
+    Eigen::VectorX<T> sample_weights = Eigen::VectorX<T>::Ones(n);
+    if (config.bootstrap) {
+        sample_weights.setZero();
+        std::uniform_int_distribution<int> draw(0, n - 1);
+        for (int i = 0; i < n; ++i) {
+            sample_weights(draw(rng)) += 1;
+        }
+    }
+
+    // Subespaço: coluna 0 + (k - 1) colunas sorteadas, em ordem crescente
+    std::vector<int>& subset = feature_subsets[b];
+    int k = static_cast<int>(std::lround(static_cast<double>(config.feature_fraction) * d));
+    if (config.feature_fraction < 1 && d > 1 && k < d) {
+        k = std::max(k, 1);
+        std::vector<int> candidates(d - 1);
+        std::iota(candidates.begin(), candidates.end(), 1);
+        std::shuffle(candidates.begin(), candidates.end(), rng);
+        subset.assign(1, 0);
+        subset.insert(subset.end(), candidates.begin(), candidates.begin() + (k - 1));
+        std::sort(subset.begin(), subset.end());
+    }
+
+    std::shared_ptr<Model<T>> member = factory();
+    if (!member) {
+        throw std::runtime_error("Member factory returned a null model");
+    }
+
+    // Subespaço: os modelos recebem MatrixRef (colunas com passo fixo), então as
+    // colunas sorteadas são reunidas no buffer da thread; k é o mesmo para todos
+    // os membros, logo o buffer é alocado uma vez por thread e não por membro
+    if (!subset.empty()) {
+        subspace_buffer = X(Eigen::all, subset);
+    }
+    const MatrixRef<T> X_member = subset.empty() ? X : MatrixRef<T>(subspace_buffer);
+
+    auto* pla = dynamic_cast<PocketPLA<T>*>(member.get());
+    auto* regression = dynamic_cast<LinearRegression<T>*>(member.get());
+    bool online = dynamic_cast<OnlineLinearRegression<T>*>(member.get()) != nullptr;
+    if (pla) {
+        pla->trainWeighted(X_member, y, sample_weights);
+    } else if (regression && !online) {
+        regression->trainWeighted(X_member, y, sample_weights);
+    } else if (config.bootstrap) {
+        // Fallback: materializa a amostra bootstrap para modelos sem pesos
+        std::vector<int> rows;
+        rows.reserve(n);
+        for (int i = 0; i < n; ++i) {
+            for (int c = 0; c < static_cast<int>(sample_weights(i)); ++c) {
+                rows.push_back(i);
+            }
+        }
+        Eigen::MatrixX<T> X_sample = X_member(rows, Eigen::all);
+        Eigen::VectorX<T> y_sample = y(rows);
+        member->train(X_sample, y_sample);
+    } else {
+        member->train(X_member, y);
+    }
+
+    members[b] = member;
+}
+
+template<typename T>
+Eigen::MatrixX<T> BaggingEnsemble<T>::memberOutputs(const MatrixRef<T>& X) const {
+    if (linear) {
+        if (X.cols() != stacked_weights.rows()) {
+            throw std::invalid_argument("Input dimension does not match the ensemble weights");
+        }
+        // Todos os membros de uma vez: n x d  *  d x B
+        Eigen::MatrixX<T> outputs = X * stacked_weights;
+        for (int b = 0; b < outputs.cols(); ++b) {
+            if (sign_outputs[b]) {
+                outputs.col(b) = outputs.col(b).array().sign();
+            }
+        }
+        return outputs;
+    }
+
+    if (members.empty()) {
+        throw std::runtime_error("Ensemble has not been trained");
+    }
+    Eigen::MatrixX<T> outputs(X.rows(), members.size());
+    for (std::size_t b = 0; b < members.size(); ++b) {
+        if (feature_subsets[b].empty()) {
+            outputs.col(b) = members[b]->predict(X);
+        } else {
+            outputs.col(b) = members[b]->predict(X(Eigen::all, feature_subsets[b]));
+        }
+    }
+    return outputs;
+}
+
+template<typename T>
+Eigen::VectorX<T> BaggingEnsemble<T>::decisionFunction(const MatrixRef<T>& X) const {
+    Eigen::MatrixX<T> outputs = memberOutputs(X);
+    if (config.ensemble_vote) {
+        return outputs.array().sign().matrix().rowwise().sum();
+    }
+    return outputs.rowwise().mean();
+}
+
+template<typename T>
+Eigen::VectorX<T> BaggingEnsemble<T>::predict(const MatrixRef<T>& X) const {
+    Eigen::VectorX<T> decision = decisionFunction(X);
+    if (config.ensemble_vote) {
+        return decision.array().sign();
+    }
+    return decision;
+}
+
+template<typename T>
+Eigen::VectorX<T> BaggingEnsemble<T>::getWeights() const {
+    if (!linear) {
+        throw std::runtime_error("Stacked weights are only available for linear members");
+    }
+    return Eigen::Map<const Eigen::VectorX<T>>(stacked_weights.data(), stacked_weights.size());
+}
+
+template<typename T>
+void BaggingEnsemble<T>::setWeights(const Eigen::VectorX<T>& new_weights) {
+    if (!linear || new_weights.size() != stacked_weights.size()) {
+        throw std::invalid_argument("Weight vector size must match the stacked ensemble weights");
+    }
+    stacked_weights = Eigen::Map<const Eigen::MatrixX<T>>(new_weights.data(), stacked_weights.rows(),
+                                                          stacked_weights.cols());
+}
+
+template<typename T>
+void BaggingEnsemble<T>::saveWeights(const std::string& filename) const {
+    if (!linear) {
+        throw std::runtime_error("Ensemble persistence requires linear members");
+    }
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    int rows = stacked_weights.rows();
+    int cols = stacked_weights.cols();
+    file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    file.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+    file.write(reinterpret_cast<const char*>(stacked_weights.data()), rows * cols * sizeof(T));
+    file.write(sign_outputs.data(), cols);
+    file.close();
+}
+
+template<typename T>
+void BaggingEnsemble<T>::loadWeights(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    // Carrega só a forma empilhada: basta para predict, sem recriar os membros
+    int rows, cols;
+    file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+    stacked_weights.resize(rows, cols);
+    sign_outputs.assign(cols, 0);
+    file.read(reinterpret_cast<char*>(stacked_weights.data()), rows * cols * sizeof(T));
+    file.read(sign_outputs.data(), cols);
+    file.close();
+
+    members.clear();
+    feature_subsets.clear();
+    linear = true;
+}
+
+// Instanciações explícitas
+template class BaggingEnsemble<float>;
+template class BaggingEnsemble<double>;
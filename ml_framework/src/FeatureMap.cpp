@@ -0,0 +1,269 @@
+// src/FeatureMap.cpp
+#include "../include/FeatureMap.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+template<typename T, typename Derived>
+void writeMatrix(std::ostream& out, const Eigen::PlainObjectBase<Derived>& M) {
+    int rows = M.rows();
+    int cols = M.cols();
+    out.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    out.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+    out.write(reinterpret_cast<const char*>(M.data()), rows * cols * sizeof(T));
+}
+
+template<typename T, typename Derived>
+void readMatrix(std::istream& in, Eigen::PlainObjectBase<Derived>& M) {
+    int rows, cols;
+    in.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    in.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+    if (!in || rows < 0 || cols < 0) {
+        throw std::runtime_error("Corrupted feature map data");
+    }
+    M.resize(rows, cols);
+    in.read(reinterpret_cast<char*>(M.data()), rows * cols * sizeof(T));
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// FeatureTransform
+
+template<typename T>
+Eigen::MatrixX<T> FeatureTransform<T>::transform(const Eigen::Ref<const Eigen::MatrixX<T>>& X) const {
+    Eigen::MatrixX<T> Z(X.rows(), outputDim());
+    const int block = blockRows();
+    for (int start = 0; start < X.rows(); start += block) {
+        int rows = std::min(block, static_cast<int>(X.rows()) - start);
+        transformBlock(X.middleRows(start, rows), Z.middleRows(start, rows));
+    }
+    return Z;
+}
+
+template<typename T>
+int FeatureTransform<T>::blockRows(std::size_t target_bytes) const {
+    std::size_t row_bytes = static_cast<std::size_t>(std::max(outputDim(), 1)) * sizeof(T);
+    return static_cast<int>(std::max<std::size_t>(16, target_bytes / row_bytes));
+}
+
+// ---------------------------------------------------------------------------
+// RandomFourierFeatures
+
+template<typename T>
+RandomFourierFeatures<T>::RandomFourierFeatures(int num_features, T gamma, unsigned int seed)
+    : num_features(num_features), gamma(gamma), seed(seed) {
+    if (num_features <= 0) {
+        throw std::invalid_argument("num_features must be positive");
+    }
+    if (gamma <= 0) {
+        throw std::invalid_argument("gamma must be positive");
+    }
+}
+
+template<typename T>
+void RandomFourierFeatures<T>::fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) {
+    // Só a dimensão de entrada importa: as frequências vêm da transformada do kernel
+    std::mt19937 rng(seed);
+    std::normal_distribution<T> normal(0, std::sqrt(2 * gamma));
+    std::uniform_real_distribution<T> phase(0, static_cast<T>(2 * M_PI));
+
+    W.resize(X.cols(), num_features);
+    for (int j = 0; j < num_features; ++j) {
+        for (int i = 0; i < W.rows(); ++i) {
+            W(i, j) = normal(rng);
+        }
+    }
+    b.resize(num_features);
+    for (int j = 0; j < num_features; ++j) {
+        b(j) = phase(rng);
+    }
+}
+
+template<typename T>
+void RandomFourierFeatures<T>::transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                                              Eigen::Ref<Eigen::MatrixX<T>> out) const {
+    if (X_block.cols() != W.rows()) {
+        throw std::invalid_argument("Input dimension does not match the fitted feature map");
+    }
+    const T scale = std::sqrt(static_cast<T>(2) / static_cast<T>(num_features));
+    out.noalias() = X_block * W;
+    out = (scale * (out.rowwise() + b).array().cos()).matrix();
+}
+
+template<typename T>
+void RandomFourierFeatures<T>::save(std::ostream& out) const {
+    out.write(reinterpret_cast<const char*>(&gamma), sizeof(gamma));
+    writeMatrix<T>(out, W);
+    writeMatrix<T>(out, b);
+}
+
+template<typename T>
+void RandomFourierFeatures<T>::load(std::istream& in) {
+    in.read(reinterpret_cast<char*>(&gamma), sizeof(gamma));
+    readMatrix<T>(in, W);
+    readMatrix<T>(in, b);
+    num_features = static_cast<int>(W.cols());
+}
+
+// ---------------------------------------------------------------------------
+// NystromFeatures
+
+template<typename T>
+NystromFeatures<T>::NystromFeatures(const Kernel<T>& kernel, int num_landmarks, unsigned int seed)
+    : kernel(kernel), num_landmarks(num_landmarks), seed(seed) {
+    if (num_landmarks <= 0) {
+        throw std::invalid_argument("num_landmarks must be positive");
+    }
+}
+
+template<typename T>
+void NystromFeatures<T>::fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) {
+    const int n = static_cast<int>(X.rows());
+    const int m = std::min(num_landmarks, n);
+    if (m == 0) {
+        throw std::invalid_argument("Cannot fit Nystrom features on an empty matrix");
+    }
+
+    // Landmarks: subconjunto aleatório sem reposição
+    std::vector<int> indices(n);
+    std::iota(indices.begin(), indices.end(), 0);
+    std::mt19937 rng(seed);
+    std::shuffle(indices.begin(), indices.end(), rng);
+
+    landmarks.resize(m, X.cols());
+    for (int k = 0; k < m; ++k) {
+        landmarks.row(k) = X.row(indices[k]);
+    }
+
+    // K_LL^{-1/2} via autodecomposição, descartando autovalores ~0
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixX<T>> eig(kernel.compute(landmarks, landmarks));
+    const Eigen::VectorX<T>& values = eig.eigenvalues();
+    T threshold = values.maxCoeff() * static_cast<T>(m) * std::numeric_limits<T>::epsilon();
+    Eigen::VectorX<T> inv_sqrt = values.unaryExpr([threshold](T v) {
+        return v > threshold ? static_cast<T>(1) / std::sqrt(v) : static_cast<T>(0);
+    });
+    normalization = eig.eigenvectors() * inv_sqrt.asDiagonal() * eig.eigenvectors().transpose();
+}
+
+template<typename T>
+void NystromFeatures<T>::transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                                        Eigen::Ref<Eigen::MatrixX<T>> out) const {
+    if (X_block.cols() != landmarks.cols()) {
+        throw std::invalid_argument("Input dimension does not match the fitted feature map");
+    }
+    out.noalias() = kernel.compute(X_block, landmarks) * normalization;
+}
+
+template<typename T>
+void NystromFeatures<T>::save(std::ostream& out) const {
+    int type = static_cast<int>(kernel.getType());
+    T gamma = kernel.getGamma();
+    int degree = kernel.getDegree();
+    T coef0 = kernel.getCoef0();
+    out.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    out.write(reinterpret_cast<const char*>(&gamma), sizeof(gamma));
+    out.write(reinterpret_cast<const char*>(&degree), sizeof(degree));
+    out.write(reinterpret_cast<const char*>(&coef0), sizeof(coef0));
+    writeMatrix<T>(out, landmarks);
+    writeMatrix<T>(out, normalization);
+}
+
+template<typename T>
+void NystromFeatures<T>::load(std::istream& in) {
+    int type, degree;
+    T gamma, coef0;
+    in.read(reinterpret_cast<char*>(&type), sizeof(type));
+    in.read(reinterpret_cast<char*>(&gamma), sizeof(gamma));
+    in.read(reinterpret_cast<char*>(&degree), sizeof(degree));
+    in.read(reinterpret_cast<char*>(&coef0), sizeof(coef0));
+    kernel = Kernel<T>(static_cast<KernelType>(type), gamma, degree, coef0);
+    readMatrix<T>(in, landmarks);
+    readMatrix<T>(in, normalization);
+    num_landmarks = static_cast<int>(landmarks.rows());
+}
+
+// ---------------------------------------------------------------------------
+// RandomizedPCA
+
+template<typename T>
+RandomizedPCA<T>::RandomizedPCA(int num_components, bool whiten, int power_iterations, int oversampling,
+                                unsigned int seed)
+    : num_components(num_components), whiten(whiten), power_iterations(power_iterations),
+      oversampling(oversampling), seed(seed) {
+    if (num_components <= 0) {
+        throw std::invalid_argument("num_components must be positive");
+    }
+}
+
+template<typename T>
+void RandomizedPCA<T>::fit(const Eigen::Ref<const Eigen::MatrixX<T>>& X) {
+    RandomizedSVD<T> svd(num_components, oversampling, power_iterations, seed);
+    setFromSVD(svd.compute(X, true));
+}
+
+template<typename T>
+void RandomizedPCA<T>::fitFromSource(BatchSource<T>& source) {
+    RandomizedSVD<T> svd(num_components, oversampling, power_iterations, seed);
+    setFromSVD(svd.compute(source, true));
+}
+
+template<typename T>
+void RandomizedPCA<T>::setFromSVD(const TruncatedSVD<T>& svd) {
+    mean = svd.mean;
+    components = svd.V;
+    T dof = static_cast<T>(std::max<long>(svd.num_samples - 1, 1));
+    explained_variance = svd.S.array().square() / dof;
+}
+
+template<typename T>
+void RandomizedPCA<T>::transformBlock(const Eigen::Ref<const Eigen::MatrixX<T>>& X_block,
+                                      Eigen::Ref<Eigen::MatrixX<T>> out) const {
+    if (X_block.cols() != components.rows()) {
+        throw std::invalid_argument("Input dimension does not match the fitted feature map");
+    }
+    out.noalias() = (X_block.rowwise() - mean) * components;
+    if (whiten) {
+        // Componentes de variância ~0 ficam zeradas em vez de explodir
+        Eigen::RowVectorX<T> scale = explained_variance.transpose().unaryExpr([](T v) {
+            return v > std::numeric_limits<T>::epsilon() ? static_cast<T>(1) / std::sqrt(v) : static_cast<T>(0);
+        });
+        out.array().rowwise() *= scale.array();
+    }
+}
+
+template<typename T>
+void RandomizedPCA<T>::save(std::ostream& out) const {
+    int whiten_flag = whiten ? 1 : 0;
+    out.write(reinterpret_cast<const char*>(&whiten_flag), sizeof(whiten_flag));
+    writeMatrix<T>(out, mean);
+    writeMatrix<T>(out, components);
+    writeMatrix<T>(out, explained_variance);
+}
+
+template<typename T>
+void RandomizedPCA<T>::load(std::istream& in) {
+    int whiten_flag;
+    in.read(reinterpret_cast<char*>(&whiten_flag), sizeof(whiten_flag));
+    whiten = whiten_flag != 0;
+    readMatrix<T>(in, mean);
+    readMatrix<T>(in, components);
+    readMatrix<T>(in, explained_variance);
+    num_components = static_cast<int>(components.cols());
+}
+
+// Instanciações explícitas
+template class FeatureTransform<float>;
+template class FeatureTransform<double>;
+template class RandomFourierFeatures<float>;
+template class RandomFourierFeatures<double>;
+template class NystromFeatures<float>;
+template class NystromFeatures<double>;
+template class RandomizedPCA<float>;
+template class RandomizedPCA<double>;
@@ -0,0 +1,114 @@
+// src/FeatureMapModel.cpp
+#include "../include/FeatureMapModel.h"
+#include "../include/LinearRegression.h"
+#include "../include/PocketPLA.h"
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+#include <typeinfo>
+
+template<typename T>
+FeatureMapModel<T>::FeatureMapModel(std::shared_ptr<FeatureTransform<T>> map, std::shared_ptr<Model<T>> inner,
+                                    bool fit_map)
+    : map(std::move(map)), inner(std::move(inner)), fit_map(fit_map) {
+    if (!this->map || !this->inner) {
+        throw std::invalid_argument("FeatureMapModel needs a feature map and an inner model");
+    }
+}
+
+template<typename T>
+void FeatureMapModel<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+
+    if (this->preprocessing_enabled) {
+        Eigen::MatrixX<T> X_processed = X;
+        Eigen::VectorX<T> y_processed = y;
+        this->preprocessData(X_processed, y_processed);
+        executeTraining(X_processed, y_processed);
+    } else {
+        executeTraining(X, y);
+    }
+}
+
+template<typename T>
+void FeatureMapModel<T>::executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (fit_map) {
+        map->fit(X);
+    }
+
+    // Tipo exato: subclasses (OnlineLinearRegression, LRClassifier) têm estado
+    // ou métricas próprias que trainFromNormalEquations não atualiza
+    if (typeid(*inner) == typeid(LinearRegression<T>)) {
+        auto* regression = static_cast<LinearRegression<T>*>(inner.get());
+        // Equações normais acumuladas bloco a bloco: Z^T Z += Z_b^T Z_b
+        const int n = static_cast<int>(X.rows());
+        const int D = map->outputDim();
+        const int block = map->blockRows();
+        Eigen::MatrixX<T> Z_block(block, D);
+        Eigen::MatrixX<T> gram = Eigen::MatrixX<T>::Zero(D, D);
+        Eigen::VectorX<T> moment = Eigen::VectorX<T>::Zero(D);
+
+        for (int start = 0; start < n; start += block) {
+            int rows = std::min(block, n - start);
+            auto Z = Z_block.topRows(rows);
+            map->transformBlock(X.middleRows(start, rows), Z);
+            gram.template selfadjointView<Eigen::Lower>().rankUpdate(Z.transpose());
+            moment.noalias() += Z.transpose() * y.segment(start, rows);
+        }
+        gram.template triangularView<Eigen::StrictlyUpper>() = gram.transpose();
+
+        regression->trainFromNormalEquations(gram, moment, y.squaredNorm(), y.sum(), n);
+    } else if (auto* pla = dynamic_cast<PocketPLA<T>*>(inner.get())) {
+        pla->trainWithFeatureMap(*map, X, y);
+    } else {
+        inner->train(map->transform(X), y);
+    }
+}
+
+template<typename T>
+Eigen::VectorX<T> FeatureMapModel<T>::predict(const MatrixRef<T>& X) const {
+    const int n = static_cast<int>(X.rows());
+    const int block = map->blockRows();
+    Eigen::MatrixX<T> Z_block(std::min(block, std::max(n, 1)), map->outputDim());
+    Eigen::VectorX<T> predictions(n);
+
+    for (int start = 0; start < n; start += block) {
+        int rows = std::min(block, n - start);
+        if (rows != Z_block.rows()) {
+            Z_block.resize(rows, Z_block.cols());
+        }
+        map->transformBlock(X.middleRows(start, rows), Z_block);
+        predictions.segment(start, rows) = inner->predict(Z_block);
+    }
+    return predictions;
+}
+
+template<typename T>
+void FeatureMapModel<T>::saveWeights(const std::string& filename) const {
+    inner->saveWeights(filename);
+
+    std::ofstream file(filename + ".map", std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename + ".map");
+    }
+    map->save(file);
+    file.close();
+}
+
+template<typename T>
+void FeatureMapModel<T>::loadWeights(const std::string& filename) {
+    inner->loadWeights(filename);
+
+    std::ifstream file(filename + ".map", std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename + ".map");
+    }
+    map->load(file);
+    file.close();
+}
+
+// Instanciações explícitas
+template class FeatureMapModel<float>;
+template class FeatureMapModel<double>;
@@ -0,0 +1,339 @@
+// src/HashingVectorizer.cpp
+#include "../include/HashingVectorizer.h"
+#include "../include/ParallelFor.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const std::uint64_t FNV_OFFSET = 14695981039346656037ULL;
+const std::uint64_t FNV_PRIME = 1099511628211ULL;
+const int MAX_NGRAM = 8;   // tamanho do buffer circular de hashes (na pilha)
+
+// Finalizador do MurmurHash3: espalha os bits antes de mascarar para 2^k
+inline std::uint64_t mix64(std::uint64_t h) {
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+// Letras e dígitos ASCII, mais qualquer byte >= 0x80 (acentos em UTF-8)
+inline bool isTokenChar(unsigned char c) {
+    return c >= 0x80 || std::isalnum(c);
+}
+
+inline unsigned char lowerAscii(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<unsigned char>(c - 'A' + 'a') : c;
+}
+
+} // namespace
+
+template<typename T>
+HashingVectorizer<T>::HashingVectorizer(int num_bits, int ngram_max, bool signed_hash, bool add_bias,
+                                        bool l2_normalize)
+    : num_bits(num_bits), ngram_max(ngram_max), signed_hash(signed_hash), add_bias(add_bias),
+      l2_normalize(l2_normalize) {
+    if (num_bits < 1 || num_bits > 30) {
+        throw std::invalid_argument("num_bits must be in [1, 30]");
+    }
+    if (ngram_max < 1 || ngram_max > MAX_NGRAM) {
+        throw std::invalid_argument("ngram_max must be in [1, 8]");
+    }
+    hash_size = 1 << num_bits;
+}
+
+template<typename T>
+std::vector<std::string> HashingVectorizer<T>::tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::string current;
+    for (unsigned char c : text) {
+        if (isTokenChar(c)) {
+            current.push_back(static_cast<char>(lowerAscii(c)));
+        } else if (!current.empty()) {
+            tokens.push_back(current);
+            current.clear();
+        }
+    }
+    if (!current.empty()) {
+        tokens.push_back(current);
+    }
+    return tokens;
+}
+
+template<typename T>
+void HashingVectorizer<T>::vectorizeText(const char* begin, const char* end, RowBlock& block,
+                                         std::vector<std::pair<int, T>>& scratch) const {
+    // Tokeniza e faz o hash numa só varredura, sem criar strings. Os últimos
+    // ngram_max hashes de token ficam num buffer circular para os n-gramas.
+    scratch.clear();
+    std::uint64_t recent[MAX_NGRAM];
+    const int window = ngram_max;
+    int seen = 0;
+    const std::uint64_t mask = static_cast<std::uint64_t>(hash_size - 1);
+
+    auto emitToken = [&](std::uint64_t token_hash) {
+        recent[seen % window] = token_hash;
+        ++seen;
+        // n-grama de tamanho n terminando no token atual
+        std::uint64_t h = 0;
+        for (int n = 1; n <= window && n <= seen; ++n) {
+            std::uint64_t part = recent[(seen - n) % window];
+            h = (n == 1) ? part : (h ^ (part + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2)));
+            std::uint64_t mixed = mix64(h + static_cast<std::uint64_t>(n));
+            T sign = (signed_hash && (mixed >> 63)) ? static_cast<T>(-1) : static_cast<T>(1);
+            scratch.emplace_back(static_cast<int>(mixed & mask), sign);
+        }
+    };
+
+    std::uint64_t h = FNV_OFFSET;
+    bool in_token = false;
+    for (const char* p = begin; p != end; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (isTokenChar(c)) {
+            h = (h ^ lowerAscii(c)) * FNV_PRIME;
+            in_token = true;
+        } else if (in_token) {
+            emitToken(h);
+            h = FNV_OFFSET;
+            in_token = false;
+        }
+    }
+    if (in_token) {
+        emitToken(h);
+    }
+
+    // Soma colisões e repetições do mesmo índice (linha CSR ordenada)
+    std::sort(scratch.begin(), scratch.end(),
+              [](const std::pair<int, T>& a, const std::pair<int, T>& b) { return a.first < b.first; });
+    std::size_t row_start = block.indices.size();
+    for (std::size_t k = 0; k < scratch.size();) {
+        int column = scratch[k].first;
+        T value = 0;
+        for (; k < scratch.size() && scratch[k].first == column; ++k) {
+            value += scratch[k].second;
+        }
+        if (value != 0) {
+            block.indices.push_back(column);
+            block.values.push_back(value);
+        }
+    }
+
+    if (l2_normalize && block.values.size() > row_start) {
+        T norm = 0;
+        for (std::size_t k = row_start; k < block.values.size(); ++k) {
+            norm += block.values[k] * block.values[k];
+        }
+        norm = std::sqrt(norm);
+        for (std::size_t k = row_start; k < block.values.size(); ++k) {
+            block.values[k] /= norm;
+        }
+    }
+
+    if (add_bias) {
+        block.indices.push_back(hash_size);
+        block.values.push_back(1);
+    }
+    block.row_sizes.push_back(static_cast<int>(block.indices.size() - row_start));
+}
+
+template<typename T>
+bool HashingVectorizer<T>::vectorizeLabeledLine(const std::string& line, RowBlock& block,
+                                                std::vector<std::pair<int, T>>& scratch) const {
+    const char* begin = line.c_str();
+    const char* end = begin + line.size();
+    while (begin != end && std::isspace(static_cast<unsigned char>(*begin))) {
+        ++begin;
+    }
+    if (begin == end) {
+        return false;  // linha vazia
+    }
+
+    char* label_end = nullptr;
+    double label = std::strtod(begin, &label_end);
+    if (label_end == begin) {
+        throw std::runtime_error("Invalid label in line: " + line);
+    }
+    block.labels.push_back(static_cast<T>(label));
+    vectorizeText(label_end, end, block, scratch);
+    return true;
+}
+
+template<typename T>
+typename HashingVectorizer<T>::SparseMatrix
+HashingVectorizer<T>::assemble(const std::vector<RowBlock>& blocks) const {
+    long rows = 0;
+    long nnz = 0;
+    for (const RowBlock& block : blocks) {
+        rows += static_cast<long>(block.row_sizes.size());
+        nnz += static_cast<long>(block.indices.size());
+    }
+
+    // Monta o CSR comprimido diretamente, na ordem dos blocos
+    SparseMatrix X(rows, numFeatures());
+    X.resizeNonZeros(nnz);
+    typename SparseMatrix::StorageIndex* outer = X.outerIndexPtr();
+    typename SparseMatrix::StorageIndex* inner = X.innerIndexPtr();
+    T* values = X.valuePtr();
+
+    long row = 0;
+    long offset = 0;
+    outer[0] = 0;
+    for (const RowBlock& block : blocks) {
+        std::copy(block.indices.begin(), block.indices.end(), inner + offset);
+        std::copy(block.values.begin(), block.values.end(), values + offset);
+        for (int size : block.row_sizes) {
+            offset += size;
+            outer[++row] = static_cast<typename SparseMatrix::StorageIndex>(offset);
+        }
+    }
+    return X;
+}
+
+template<typename T>
+typename HashingVectorizer<T>::SparseMatrix
+HashingVectorizer<T>::transform(const std::vector<std::string>& documents, int num_threads) const {
+    const int n = static_cast<int>(documents.size());
+    const int threads = parallelThreads(num_threads, n);
+    std::vector<RowBlock> blocks(threads);
+
+    parallelFor(threads, threads, [&](int t, int) {
+        std::vector<std::pair<int, T>> scratch;
+        int first = static_cast<int>(static_cast<long>(n) * t / threads);
+        int last = static_cast<int>(static_cast<long>(n) * (t + 1) / threads);
+        for (int i = first; i < last; ++i) {
+            const std::string& doc = documents[i];
+            vectorizeText(doc.data(), doc.data() + doc.size(), blocks[t], scratch);
+        }
+    });
+    return assemble(blocks);
+}
+
+template<typename T>
+void HashingVectorizer<T>::transformFile(const std::string& filename, SparseMatrix& X, Eigen::VectorX<T>& y,
+                                         int num_threads) const {
+    std::ifstream probe(filename, std::ios::binary | std::ios::ate);
+    if (!probe.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+    const long file_size = static_cast<long>(probe.tellg());
+    probe.close();
+
+    // Cada thread fica com uma faixa de bytes; uma linha pertence à faixa em
+    // que começa, então as fronteiras são ajustadas para o início de linha
+    const long ranges = std::min<long>(file_size / 4096, 1 << 16);   // faixas de pelo menos 4 KB
+    const int threads = parallelThreads(num_threads, static_cast<int>(ranges));
+    std::vector<RowBlock> blocks(threads);
+
+    parallelFor(threads, threads, [&](int t, int) {
+        const long range_begin = file_size * t / threads;
+        const long range_end = file_size * (t + 1) / threads;
+        std::ifstream file(filename, std::ios::binary);
+        if (!file.is_open()) {
+            throw std::runtime_error("Cannot open file for reading: " + filename);
+        }
+
+        std::string line;
+        long position = range_begin;
+        if (range_begin > 0) {
+            // Descarta o resto da linha que começou na faixa anterior
+            file.seekg(range_begin - 1);
+            std::getline(file, line);
+            position = range_begin - 1 + static_cast<long>(line.size()) + 1;
+        }
+
+        std::vector<std::pair<int, T>> scratch;
+        while (position < range_end && std::getline(file, line)) {
+            position += static_cast<long>(line.size()) + 1;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            vectorizeLabeledLine(line, blocks[t], scratch);
+        }
+    });
+
+    X = assemble(blocks);
+    y.resize(X.rows());
+    long offset = 0;
+    for (const RowBlock& block : blocks) {
+        for (T label : block.labels) {
+            y(offset++) = label;
+        }
+    }
+}
+
+template<typename T>
+void HashingVectorizer<T>::streamFile(const std::string& filename, int batch_rows,
+                                      const std::function<void(const SparseMatrix&, const Eigen::VectorX<T>&)>& consumer,
+                                      int num_threads) const {
+    if (batch_rows <= 0) {
+        throw std::invalid_argument("batch_rows must be positive");
+    }
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    const int threads = parallelThreads(num_threads, batch_rows);
+    std::vector<std::string> lines;
+    lines.reserve(batch_rows);
+    std::vector<RowBlock> blocks(threads);
+    std::vector<std::vector<std::pair<int, T>>> scratch(threads);
+    SparseMatrix X_batch;
+    Eigen::VectorX<T> y_batch;
+    std::string line;
+
+    bool more = true;
+    while (more) {
+        lines.clear();
+        while (static_cast<int>(lines.size()) < batch_rows && (more = static_cast<bool>(std::getline(file, line)))) {
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            lines.push_back(line);
+        }
+        if (lines.empty()) {
+            break;
+        }
+
+        // O leitor é sequencial; a vetorização do batch é dividida entre as threads
+        const int n = static_cast<int>(lines.size());
+        const int active = std::min(threads, n);
+        for (RowBlock& block : blocks) {
+            block.row_sizes.clear();
+            block.indices.clear();
+            block.values.clear();
+            block.labels.clear();
+        }
+        parallelFor(active, active, [&](int t, int) {
+            int first = static_cast<int>(static_cast<long>(n) * t / active);
+            int last = static_cast<int>(static_cast<long>(n) * (t + 1) / active);
+            for (int i = first; i < last; ++i) {
+                vectorizeLabeledLine(lines[i], blocks[t], scratch[t]);
+            }
+        });
+
+        // Blocos inativos estão vazios e não contribuem com linhas
+        X_batch = assemble(blocks);
+        y_batch.resize(X_batch.rows());
+        long offset = 0;
+        for (const RowBlock& block : blocks) {
+            for (T label : block.labels) {
+                y_batch(offset++) = label;
+            }
+        }
+        if (X_batch.rows() > 0) {
+            consumer(X_batch, y_batch);
+        }
+    }
+}
+
+// Instanciações explícitas
+template class HashingVectorizer<float>;
+template class HashingVectorizer<double>;
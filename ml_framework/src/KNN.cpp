@@ -0,0 +1,345 @@
+// src/KNN.cpp
+#include "../include/KNN.h"
+#include "../include/ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+const int QUERY_BLOCK_ROWS = 256;
+const long TRAIN_TILE_BYTES = 512 * 1024;   // faixa de treino convertida cabe no L2
+
+} // namespace
+
+template<typename T>
+KNN<T>::KNN() : config() {}
+
+template<typename T>
+KNN<T>::KNN(const TrainingConfig<T>& config) : config(config) {}
+
+template<typename T>
+void KNN<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+
+    if (this->preprocessing_enabled) {
+        Eigen::MatrixX<T> X_processed = X;
+        Eigen::VectorX<T> y_processed = y;
+        this->preprocessData(X_processed, y_processed);
+        executeTraining(X_processed, y_processed);
+    } else {
+        executeTraining(X, y);
+    }
+}
+
+template<typename T>
+void KNN<T>::executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() == 0) {
+        throw std::invalid_argument("Cannot train KNN on an empty matrix");
+    }
+
+    storage = config.knn_storage;
+    num_features = static_cast<int>(X.cols());
+    labels = y;
+    data_full.resize(0, 0);
+    data_half.resize(0, 0);
+    data_int8.resize(0, 0);
+    row_scales.resize(0);
+
+    switch (storage) {
+    case KnnStorage::Full:
+        data_full = X;
+        break;
+    case KnnStorage::Half:
+        data_half = X.template cast<Eigen::half>();
+        break;
+    case KnnStorage::Int8: {
+        // Escala simétrica por linha: q = round(x / s), s = max|x| / 127
+        row_scales = X.cwiseAbs().rowwise().maxCoeff() / static_cast<T>(127);
+        data_int8.resize(X.rows(), X.cols());
+        for (int i = 0; i < X.rows(); ++i) {
+            T inverse = row_scales(i) > 0 ? 1 / row_scales(i) : 0;
+            for (int j = 0; j < X.cols(); ++j) {
+                data_int8(i, j) = static_cast<std::int8_t>(std::lround(X(i, j) * inverse));
+            }
+        }
+        break;
+    }
+    }
+
+    computeNorms();
+}
+
+template<typename T>
+void KNN<T>::computeNorms() {
+    // |b|² do valor armazenado (após conversão), coerente com o GEMM da busca
+    const int n = static_cast<int>(labels.size());
+    sq_norms.resize(n);
+    if (storage == KnnStorage::Full) {
+        sq_norms = data_full.rowwise().squaredNorm();
+        return;
+    }
+    const int tile_rows = trainingTileRows();
+    Eigen::MatrixX<T> tile(tile_rows, num_features);
+    for (int start = 0; start < n; start += tile_rows) {
+        int rows = std::min(tile_rows, n - start);
+        decodeRows(start, rows, tile);
+        sq_norms.segment(start, rows) = tile.topRows(rows).rowwise().squaredNorm();
+    }
+}
+
+template<typename T>
+int KNN<T>::trainingTileRows() const {
+    long rows = TRAIN_TILE_BYTES / (std::max(1, num_features) * static_cast<long>(sizeof(T)));
+    rows = std::max(64L, rows);
+    return static_cast<int>(std::min<long>(rows, std::max<long>(1, labels.size())));
+}
+
+template<typename T>
+void KNN<T>::decodeRows(int start, int rows, Eigen::MatrixX<T>& out) const {
+    switch (storage) {
+    case KnnStorage::Full:
+        out.topRows(rows) = data_full.middleRows(start, rows);
+        break;
+    case KnnStorage::Half:
+        out.topRows(rows) = data_half.middleRows(start, rows).template cast<T>();
+        break;
+    case KnnStorage::Int8:
+        out.topRows(rows) = (data_int8.middleRows(start, rows).template cast<T>().array().colwise()
+                             * row_scales.segment(start, rows).array()).matrix();
+        break;
+    }
+}
+
+template<typename T>
+void KNN<T>::searchBlock(const MatrixRef<T>& queries, int k, std::pair<T, int>* best,
+                         Eigen::MatrixX<T>& tile, Eigen::MatrixX<T>& distances) const {
+    const int m = static_cast<int>(queries.rows());
+    const int n = static_cast<int>(labels.size());
+    const int tile_rows = static_cast<int>(tile.rows());
+    const Eigen::VectorX<T> query_norms = queries.rowwise().squaredNorm();
+    std::vector<int> heap_size(m, 0);
+
+    for (int start = 0; start < n; start += tile_rows) {
+        int rows = std::min(tile_rows, n - start);
+        if (storage != KnnStorage::Full) {
+            decodeRows(start, rows, tile);
+        }
+        const MatrixRef<T> train_tile = storage == KnnStorage::Full
+                                            ? MatrixRef<T>(data_full.middleRows(start, rows))
+                                            : MatrixRef<T>(tile.topRows(rows));
+
+        // Faixa de treino x consultas: cada coluna (uma consulta) é contígua
+        auto D = distances.topLeftCorner(rows, m);
+        D.noalias() = static_cast<T>(-2) * train_tile * queries.transpose();
+        D.colwise() += sq_norms.segment(start, rows);
+        D.rowwise() += query_norms.transpose();
+
+        for (int q = 0; q < m; ++q) {
+            std::pair<T, int>* heap = best + static_cast<long>(q) * k;
+            int& size = heap_size[q];
+            for (int r = 0; r < rows; ++r) {
+                std::pair<T, int> candidate(std::max(D(r, q), static_cast<T>(0)), start + r);
+                if (size < k) {
+                    heap[size++] = candidate;
+                    std::push_heap(heap, heap + size);
+                } else if (candidate < heap[0]) {
+                    std::pop_heap(heap, heap + k);
+                    heap[k - 1] = candidate;
+                    std::push_heap(heap, heap + k);
+                }
+            }
+        }
+    }
+
+    for (int q = 0; q < m; ++q) {
+        std::pair<T, int>* heap = best + static_cast<long>(q) * k;
+        std::sort_heap(heap, heap + k);
+    }
+}
+
+template<typename T>
+std::vector<std::pair<T, int>> KNN<T>::searchAll(const MatrixRef<T>& X, int k) const {
+    if (labels.size() == 0) {
+        throw std::runtime_error("KNN model has not been trained");
+    }
+    if (X.cols() != num_features) {
+        throw std::invalid_argument("X has a different number of features than the training set");
+    }
+
+    const int m = static_cast<int>(X.rows());
+    std::vector<std::pair<T, int>> best(static_cast<std::size_t>(m) * k);
+    const int blocks = (m + QUERY_BLOCK_ROWS - 1) / QUERY_BLOCK_ROWS;
+    if (blocks == 0) {
+        return best;
+    }
+
+    // Blocos de consultas distribuídos dinamicamente; buffers por thread
+    const int threads = parallelThreads(config.num_threads, blocks);
+    const int tile_rows = trainingTileRows();
+    // Full lê direto de data_full: o buffer só informa a altura da faixa
+    const int tile_cols = storage == KnnStorage::Full ? 0 : static_cast<int>(num_features);
+    std::vector<Eigen::MatrixX<T>> tiles(threads, Eigen::MatrixX<T>(tile_rows, tile_cols));
+    std::vector<Eigen::MatrixX<T>> distances(threads, Eigen::MatrixX<T>(tile_rows, QUERY_BLOCK_ROWS));
+    // Com mais de uma thread externa cada GEMM roda sequencial (senão seriam
+    // núcleos x núcleos threads disputando as mesmas faixas do L2); com uma
+    // só, o GEMM usa as threads do Eigen
+    EigenThreadsGuard eigen_threads(threads > 1 ? 1 : Eigen::nbThreads());
+    parallelFor(blocks, threads, [&](int b, int t) {
+        int start = b * QUERY_BLOCK_ROWS;
+        int rows = std::min(QUERY_BLOCK_ROWS, m - start);
+        searchBlock(X.middleRows(start, rows), k, best.data() + static_cast<long>(start) * k,
+                    tiles[t], distances[t]);
+    });
+    return best;
+}
+
+template<typename T>
+void KNN<T>::kneighbors(const MatrixRef<T>& X, Eigen::MatrixXi& indices, Eigen::MatrixX<T>& distances) const {
+    if (config.knn_k <= 0) {
+        throw std::invalid_argument("knn_k must be positive");
+    }
+    const int k = std::min(config.knn_k, getTrainingSize());
+    std::vector<std::pair<T, int>> best = searchAll(X, k);
+
+    indices.resize(X.rows(), k);
+    distances.resize(X.rows(), k);
+    for (int i = 0; i < X.rows(); ++i) {
+        for (int j = 0; j < k; ++j) {
+            const std::pair<T, int>& neighbor = best[static_cast<std::size_t>(i) * k + j];
+            distances(i, j) = neighbor.first;
+            indices(i, j) = neighbor.second;
+        }
+    }
+}
+
+template<typename T>
+Eigen::VectorX<T> KNN<T>::predict(const MatrixRef<T>& X) const {
+    if (config.knn_k <= 0) {
+        throw std::invalid_argument("knn_k must be positive");
+    }
+    const int k = std::min(config.knn_k, getTrainingSize());
+    std::vector<std::pair<T, int>> best = searchAll(X, k);
+
+    // Voto majoritário; empate decidido pelo rótulo do vizinho mais próximo
+    // (os vizinhos estão em ordem crescente de distância)
+    Eigen::VectorX<T> predictions(X.rows());
+    std::vector<std::pair<T, int>> votes;
+    votes.reserve(k);
+    for (int i = 0; i < X.rows(); ++i) {
+        votes.clear();
+        for (int j = 0; j < k; ++j) {
+            T label = labels(best[static_cast<std::size_t>(i) * k + j].second);
+            auto it = std::find_if(votes.begin(), votes.end(),
+                                   [label](const std::pair<T, int>& vote) { return vote.first == label; });
+            if (it == votes.end()) {
+                votes.emplace_back(label, 1);
+            } else {
+                ++it->second;
+            }
+        }
+        auto winner = votes.begin();
+        for (auto it = votes.begin(); it != votes.end(); ++it) {
+            if (it->second > winner->second) {
+                winner = it;
+            }
+        }
+        predictions(i) = winner->first;
+    }
+    return predictions;
+}
+
+template<typename T>
+void KNN<T>::setWeights(const Eigen::VectorX<T>& new_weights) {
+    if (new_weights.size() != labels.size()) {
+        throw std::invalid_argument("Label vector size must match the training set size");
+    }
+    labels = new_weights;
+}
+
+template<typename T>
+std::size_t KNN<T>::getStorageBytes() const {
+    return data_full.size() * sizeof(T) + data_half.size() * sizeof(Eigen::half)
+           + data_int8.size() * sizeof(std::int8_t) + row_scales.size() * sizeof(T);
+}
+
+template<typename T>
+void KNN<T>::saveWeights(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    // Conjunto de treino no formato armazenado; as normas são recalculadas no load
+    int rows = static_cast<int>(labels.size());
+    int cols = num_features;
+    int format = static_cast<int>(storage);
+    file.write(reinterpret_cast<const char*>(&format), sizeof(format));
+    file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    file.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+    file.write(reinterpret_cast<const char*>(labels.data()), rows * sizeof(T));
+    switch (storage) {
+    case KnnStorage::Full:
+        file.write(reinterpret_cast<const char*>(data_full.data()), rows * cols * sizeof(T));
+        break;
+    case KnnStorage::Half:
+        file.write(reinterpret_cast<const char*>(data_half.data()), rows * cols * sizeof(Eigen::half));
+        break;
+    case KnnStorage::Int8:
+        file.write(reinterpret_cast<const char*>(row_scales.data()), rows * sizeof(T));
+        file.write(reinterpret_cast<const char*>(data_int8.data()), rows * cols * sizeof(std::int8_t));
+        break;
+    }
+    file.close();
+}
+
+template<typename T>
+void KNN<T>::loadWeights(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    int format, rows, cols;
+    file.read(reinterpret_cast<char*>(&format), sizeof(format));
+    file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+    if (format < 0 || format > static_cast<int>(KnnStorage::Int8)) {
+        throw std::runtime_error("Unknown KNN storage format in: " + filename);
+    }
+
+    storage = static_cast<KnnStorage>(format);
+    num_features = cols;
+    labels.resize(rows);
+    data_full.resize(0, 0);
+    data_half.resize(0, 0);
+    data_int8.resize(0, 0);
+    row_scales.resize(0);
+    file.read(reinterpret_cast<char*>(labels.data()), rows * sizeof(T));
+    switch (storage) {
+    case KnnStorage::Full:
+        data_full.resize(rows, cols);
+        file.read(reinterpret_cast<char*>(data_full.data()), rows * cols * sizeof(T));
+        break;
+    case KnnStorage::Half:
+        data_half.resize(rows, cols);
+        file.read(reinterpret_cast<char*>(data_half.data()), rows * cols * sizeof(Eigen::half));
+        break;
+    case KnnStorage::Int8:
+        row_scales.resize(rows);
+        data_int8.resize(rows, cols);
+        file.read(reinterpret_cast<char*>(row_scales.data()), rows * sizeof(T));
+        file.read(reinterpret_cast<char*>(data_int8.data()), rows * cols * sizeof(std::int8_t));
+        break;
+    }
+    file.close();
+
+    computeNorms();
+}
+
+// Instanciações explícitas
+template class KNN<float>;
+template class KNN<double>;
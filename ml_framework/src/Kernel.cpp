@@ -0,0 +1,117 @@
+// src/Kernel.cpp
+#include "../include/Kernel.h"
+#include <algorithm>
+#include <stdexcept>
+
+template<typename T>
+Kernel<T>::Kernel(KernelType type, T gamma, int degree, T coef0)
+    : type(type), gamma(gamma), degree(degree), coef0(coef0) {
+    if (gamma <= 0) {
+        throw std::invalid_argument("Kernel gamma must be positive");
+    }
+    if (type == KernelType::Polynomial && degree < 1) {
+        throw std::invalid_argument("Polynomial kernel degree must be >= 1");
+    }
+}
+
+template<typename T>
+Eigen::MatrixX<T> Kernel<T>::compute(const Eigen::Ref<const Eigen::MatrixX<T>>& A,
+                                     const Eigen::Ref<const Eigen::MatrixX<T>>& B) const {
+    Eigen::MatrixX<T> K;
+    K.noalias() = A * B.transpose();
+
+    switch (type) {
+        case KernelType::Linear:
+            break;
+        case KernelType::RBF: {
+            // |a - b|² = |a|² + |b|² - 2<a, b>
+            Eigen::VectorX<T> a_norms = A.rowwise().squaredNorm();
+            Eigen::RowVectorX<T> b_norms = B.rowwise().squaredNorm().transpose();
+            K = (static_cast<T>(-2) * K).colwise() + a_norms;
+            K.rowwise() += b_norms;
+            K = (-gamma * K.array()).min(static_cast<T>(0)).exp().matrix();
+            break;
+        }
+        case KernelType::Polynomial:
+            K = (gamma * K.array() + coef0).pow(static_cast<T>(degree)).matrix();
+            break;
+    }
+    return K;
+}
+
+template<typename T>
+void Kernel<T>::computeRow(const Eigen::Ref<const Eigen::MatrixX<T>>& X, const Eigen::VectorX<T>& sq_norms,
+                           int j, Eigen::Ref<Eigen::VectorX<T>> out) const {
+    out.noalias() = X * X.row(j).transpose();
+
+    switch (type) {
+        case KernelType::Linear:
+            break;
+        case KernelType::RBF:
+            out = (-gamma * (sq_norms.array() + sq_norms(j) - static_cast<T>(2) * out.array())).min(static_cast<T>(0)).exp().matrix();
+            break;
+        case KernelType::Polynomial:
+            out = (gamma * out.array() + coef0).pow(static_cast<T>(degree)).matrix();
+            break;
+    }
+}
+
+template<typename T>
+KernelRowCache<T>::KernelRowCache(int row_length, std::size_t max_bytes) : row_length(row_length) {
+    std::size_t row_bytes = static_cast<std::size_t>(std::max(row_length, 1)) * sizeof(T);
+    max_rows = static_cast<int>(std::max<std::size_t>(1, max_bytes / row_bytes));
+    entries.reserve(max_rows);
+}
+
+template<typename T>
+const Eigen::VectorX<T>* KernelRowCache<T>::find(int key) {
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        ++misses;
+        return nullptr;
+    }
+    ++hits;
+    lru.splice(lru.begin(), lru, it->second.position);
+    return &it->second.row;
+}
+
+template<typename T>
+Eigen::VectorX<T>& KernelRowCache<T>::insert(int key) {
+    auto existing = entries.find(key);
+    if (existing != entries.end()) {
+        lru.splice(lru.begin(), lru, existing->second.position);
+        return existing->second.row;
+    }
+
+    Eigen::VectorX<T> storage;
+    if (static_cast<int>(entries.size()) >= max_rows) {
+        // Despeja a linha menos recente e reaproveita sua memória
+        int victim = lru.back();
+        lru.pop_back();
+        auto it = entries.find(victim);
+        storage.swap(it->second.row);
+        entries.erase(it);
+    } else {
+        storage.resize(row_length);
+    }
+
+    lru.push_front(key);
+    Entry& entry = entries[key];
+    entry.position = lru.begin();
+    entry.row.swap(storage);
+    return entry.row;
+}
+
+template<typename T>
+void KernelRowCache<T>::clear() {
+    lru.clear();
+    entries.clear();
+    hits = 0;
+    misses = 0;
+}
+
+// Instanciações explícitas
+template class Kernel<float>;
+template class Kernel<double>;
+template class KernelRowCache<float>;
+template class KernelRowCache<double>;
@@ -0,0 +1,216 @@
+// src/KernelPerceptron.cpp
+#include "../include/KernelPerceptron.h"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+template<typename T>
+KernelPerceptron<T>::KernelPerceptron(const Kernel<T>& kernel) : kernel(kernel) {
+    config = TrainingConfig<T>();
+}
+
+template<typename T>
+KernelPerceptron<T>::KernelPerceptron(const Kernel<T>& kernel, const TrainingConfig<T>& config)
+    : kernel(kernel), config(config) {}
+
+template<typename T>
+void KernelPerceptron<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+
+    if (this->preprocessing_enabled) {
+        Eigen::MatrixX<T> X_processed = X;
+        Eigen::VectorX<T> y_processed = y;
+        this->preprocessData(X_processed, y_processed);
+        executeTraining(X_processed, y_processed);
+    } else {
+        executeTraining(X, y);
+    }
+}
+
+template<typename T>
+void KernelPerceptron<T>::executeTraining(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    const int n = static_cast<int>(X.rows());
+    const Eigen::VectorX<T> sq_norms = X.rowwise().squaredNorm();
+
+    Eigen::VectorX<T> alpha = Eigen::VectorX<T>::Zero(n);
+    Eigen::VectorX<T> decision = Eigen::VectorX<T>::Zero(n);
+    T current_bias = 0;
+
+    // Com alpha = 0 todo f_i = 0, logo todo ponto está mal classificado
+    int errors = n;
+    Eigen::VectorX<T> best_alpha = alpha;
+    T best_bias = 0;
+    int best_errors = errors;
+    std::vector<T> error_history;
+
+    KernelRowCache<T> cache(n, static_cast<std::size_t>(std::max(config.kernel_cache_bytes, 0L)));
+    bool converged = false;
+    int cursor = 0;
+
+    for (iterations = 0; iterations < config.max_iterations; ++iterations) {
+        T current_error = static_cast<T>(errors) / static_cast<T>(n);
+        error_history.push_back(current_error);
+        if (errors == 0 || current_error <= config.tolerance) {
+            converged = true;
+            break;
+        }
+
+        // Prefere um ponto mal classificado cuja linha já está em cache: a
+        // varredura circular sozinha, com n >> capacidade, despeja cada linha
+        // antes de voltar a ela e o cache nunca acertaria
+        auto misclassified = [&](int i) { return decision(i) * y(i) <= 0; };
+        int j = config.kernel_cache_first ? cache.findKey(misclassified) : -1;
+        if (j == -1) {
+            // Próximo ponto mal classificado a partir do cursor (varredura circular)
+            for (int k = 0; k < n; ++k) {
+                int i = (cursor + k) % n;
+                if (misclassified(i)) {
+                    j = i;
+                    break;
+                }
+            }
+            if (j == -1) {
+                converged = true;
+                break;
+            }
+            cursor = (j + 1) % n;
+        }
+
+        const Eigen::VectorX<T>* row = cache.find(j);
+        if (row == nullptr) {
+            Eigen::VectorX<T>& slot = cache.insert(j);
+            kernel.computeRow(X, sq_norms, j, slot);
+            row = &slot;
+        }
+
+        // alpha_j += 1  =>  f_i += y_j (K(x_i, x_j) + 1) para todo i
+        alpha(j) += 1;
+        current_bias += y(j);
+        decision.array() += y(j) * (row->array() + static_cast<T>(1));
+        errors = static_cast<int>((decision.array() * y.array() <= static_cast<T>(0)).count());
+
+        if (errors < best_errors) {
+            best_errors = errors;
+            best_alpha = alpha;
+            best_bias = current_bias;
+        }
+    }
+
+    final_error = static_cast<T>(best_errors) / static_cast<T>(n);
+    cache_hits = cache.getHits();
+    cache_misses = cache.getMisses();
+
+    // Guarda apenas os vetores de suporte do pocket
+    int support = static_cast<int>((best_alpha.array() > static_cast<T>(0)).count());
+    support_vectors.resize(support, X.cols());
+    coefficients.resize(support);
+    for (int i = 0, k = 0; i < n; ++i) {
+        if (best_alpha(i) > 0) {
+            support_vectors.row(k) = X.row(i);
+            coefficients(k) = best_alpha(i) * y(i);
+            ++k;
+        }
+    }
+    bias = best_bias;
+
+    Eigen::VectorX<T> final_predictions = predict(X);
+    training_metrics = Metrics<T>::calculateClassificationMetrics(y, final_predictions);
+    training_metrics.training_history = error_history;
+
+    if (config.verbose) {
+        std::cout << "Kernel perceptron training completed: " << iterations << " iterations, "
+                  << "final error: " << final_error << ", "
+                  << "support vectors: " << support << ", "
+                  << "cache hits/misses: " << cache_hits << "/" << cache_misses << ", "
+                  << "converged: " << (converged ? "yes" : "no") << std::endl;
+    }
+}
+
+template<typename T>
+Eigen::VectorX<T> KernelPerceptron<T>::decisionFunction(const MatrixRef<T>& X) const {
+    // O termo "+1" do kernel aumentado já está acumulado em bias
+    Eigen::VectorX<T> scores = Eigen::VectorX<T>::Constant(X.rows(), bias);
+    if (support_vectors.rows() == 0) {
+        return scores;
+    }
+
+    // Blocos de consultas limitam a matriz de kernel temporária a block x SV
+    const int block = 256;
+    for (int start = 0; start < X.rows(); start += block) {
+        int rows = std::min(block, static_cast<int>(X.rows()) - start);
+        Eigen::MatrixX<T> K = kernel.compute(X.middleRows(start, rows), support_vectors);
+        scores.segment(start, rows).noalias() += K * coefficients;
+    }
+    return scores;
+}
+
+template<typename T>
+Eigen::VectorX<T> KernelPerceptron<T>::predict(const MatrixRef<T>& X) const {
+    return decisionFunction(X).array().sign();
+}
+
+template<typename T>
+void KernelPerceptron<T>::setWeights(const Eigen::VectorX<T>& new_weights) {
+    if (new_weights.size() != support_vectors.rows()) {
+        throw std::invalid_argument("Weight vector size must match the number of support vectors");
+    }
+    coefficients = new_weights;
+}
+
+template<typename T>
+void KernelPerceptron<T>::saveWeights(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    int type = static_cast<int>(kernel.getType());
+    T gamma = kernel.getGamma();
+    int degree = kernel.getDegree();
+    T coef0 = kernel.getCoef0();
+    int rows = support_vectors.rows();
+    int cols = support_vectors.cols();
+
+    file.write(reinterpret_cast<const char*>(&type), sizeof(type));
+    file.write(reinterpret_cast<const char*>(&gamma), sizeof(gamma));
+    file.write(reinterpret_cast<const char*>(&degree), sizeof(degree));
+    file.write(reinterpret_cast<const char*>(&coef0), sizeof(coef0));
+    file.write(reinterpret_cast<const char*>(&bias), sizeof(bias));
+    file.write(reinterpret_cast<const char*>(&rows), sizeof(rows));
+    file.write(reinterpret_cast<const char*>(&cols), sizeof(cols));
+    file.write(reinterpret_cast<const char*>(support_vectors.data()), rows * cols * sizeof(T));
+    file.write(reinterpret_cast<const char*>(coefficients.data()), rows * sizeof(T));
+    file.close();
+}
+
+template<typename T>
+void KernelPerceptron<T>::loadWeights(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    int type, degree, rows, cols;
+    T gamma, coef0;
+    file.read(reinterpret_cast<char*>(&type), sizeof(type));
+    file.read(reinterpret_cast<char*>(&gamma), sizeof(gamma));
+    file.read(reinterpret_cast<char*>(&degree), sizeof(degree));
+    file.read(reinterpret_cast<char*>(&coef0), sizeof(coef0));
+    file.read(reinterpret_cast<char*>(&bias), sizeof(bias));
+    file.read(reinterpret_cast<char*>(&rows), sizeof(rows));
+    file.read(reinterpret_cast<char*>(&cols), sizeof(cols));
+    kernel = Kernel<T>(static_cast<KernelType>(type), gamma, degree, coef0);
+
+    support_vectors.resize(rows, cols);
+    coefficients.resize(rows);
+    file.read(reinterpret_cast<char*>(support_vectors.data()), rows * cols * sizeof(T));
+    file.read(reinterpret_cast<char*>(coefficients.data()), rows * sizeof(T));
+    file.close();
+}
+
+// Instanciações explícitas
+template class KernelPerceptron<float>;
+template class KernelPerceptron<double>;
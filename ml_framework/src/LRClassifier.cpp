@@ -9,11 +9,15 @@ template<typename T>
 LRClassifier<T>::LRClassifier(const TrainingConfig<T>& config) : LinearRegression<T>(config) {}
 
 template<typename T>
-void LRClassifier<T>::train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
+void LRClassifier<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
     // Chama train da classe base (LinearRegression)
     LinearRegression<T>::train(X, y);
     
-    // Calcula métricas de classificação adicionais
+    // Calcula métricas de classificação adicionais (única passada extra sobre X;
+    // as de regressão já saíram das estatísticas suficientes)
+    if (this->config.metrics_mode == MetricsMode::Skip) {
+        return;
+    }
     calculateClassificationMetrics(X, y);
     
     if (this->config.verbose) {
@@ -22,12 +26,58 @@ void LRClassifier<T>::train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>&
 }
 
 template<typename T>
-Eigen::VectorX<T> LRClassifier<T>::predict(const Eigen::MatrixX<T>& X) const {
+Eigen::VectorX<T> LRClassifier<T>::predict(const MatrixRef<T>& X) const {
     // Usa a predição da regressão linear e aplica função sign para classificação
     Eigen::VectorX<T> regression_predictions = LinearRegression<T>::predict(X);
     return regression_predictions.array().sign();
 }
 
+template<typename T>
+void LRClassifier<T>::predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const {
+    LinearRegression<T>::predictInto(X, out);
+    out = out.array().sign();
+}
+
+template<typename T>
+void LRClassifier<T>::trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) {
+    LinearRegression<T>::trainRowMajor(X, y);
+    
+    if (this->config.metrics_mode == MetricsMode::Skip) {
+        return;
+    }
+    classification_metrics = Metrics<T>::calculateClassificationMetrics(y, predictRowMajor(X));
+}
+
+template<typename T>
+Eigen::VectorX<T> LRClassifier<T>::predictRowMajor(const RowMajorRef<T>& X) const {
+    return LinearRegression<T>::predictRowMajor(X).array().sign();
+}
+
+template<typename T>
+void LRClassifier<T>::trainSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X, const VectorRef<T>& y) {
+    LinearRegression<T>::trainSparse(X, y);
+    
+    if (this->config.metrics_mode == MetricsMode::Skip) {
+        return;
+    }
+    classification_metrics = Metrics<T>::calculateClassificationMetrics(y, predictSparse(X));
+    
+    if (this->config.verbose) {
+        std::cout << "Classification Accuracy: " << classification_metrics.accuracy << std::endl;
+    }
+}
+
+template<typename T>
+Eigen::VectorX<T> LRClassifier<T>::predictSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X) const {
+    return LinearRegression<T>::predictSparse(X).array().sign();
+}
+
+template<typename T>
+void LRClassifier<T>::computeMetrics(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    LinearRegression<T>::computeMetrics(X, y);
+    calculateClassificationMetrics(X, y);
+}
+
 template<typename T>
 Eigen::VectorX<T> LRClassifier<T>::getDecisionBoundary(const Eigen::VectorX<T>& regressionX, T shift) const {
     // Equivalente ao getRegressionY do Python: (-w[0]+shift - w[1]*regressionX) / w[2]
@@ -45,8 +95,10 @@ Eigen::VectorX<T> LRClassifier<T>::getDecisionBoundary(const Eigen::VectorX<T>&
 }
 
 template<typename T>
-void LRClassifier<T>::calculateClassificationMetrics(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
-    Eigen::VectorX<T> predictions = predict(X);
+void LRClassifier<T>::calculateClassificationMetrics(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    Workspace::Scope scratch(this->workspace.get());
+    auto predictions = scratch.vector<T>(X.rows());
+    predictInto(X, predictions);
     classification_metrics = Metrics<T>::calculateClassificationMetrics(y, predictions);
 }
 
@@ -1,7 +1,14 @@
 // src/LinearRegression.cpp
 #include "../include/LinearRegression.h"
+#include "../include/RandomizedSVD.h"
+#include <Eigen/IterativeLinearSolvers>
 #include <iostream>
 #include <fstream>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
 
 template<typename T>
 LinearRegression<T>::LinearRegression() {
@@ -12,49 +19,131 @@ template<typename T>
 LinearRegression<T>::LinearRegression(const TrainingConfig<T>& config) : config(config) {}
 
 template<typename T>
-void LinearRegression<T>::train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
+void LinearRegression<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    has_sufficient_stats = false;
+    has_cached_rss = false;
+    metrics_computed = false;
+    
     if (this->preprocessing_enabled) {
         Eigen::MatrixX<T> X_processed = X;
         Eigen::VectorX<T> y_processed = y;
         this->preprocessData(X_processed, y_processed);
-        
-        if (!solveDirect(X_processed, y_processed)) {
-            if (config.verbose) {
-                std::cout << "Direct solution failed, using SVD fallback..." << std::endl;
-            }
-            solveSVD(X_processed, y_processed);
-        }
+        solve(X_processed, y_processed);
     } else {
-        if (!solveDirect(X, y)) {
-            if (config.verbose) {
-                std::cout << "Direct solution failed, using SVD fallback..." << std::endl;
-            }
-            solveSVD(X, y);
-        }
+        solve(X, y);
     }
     
-    calculateMetrics(X, y);
+    // Com pré-processamento as estatísticas descrevem os dados transformados
+    if (this->preprocessing_enabled) {
+        has_sufficient_stats = false;
+    }
+    updateTrainingMetrics(X, y);
     
     if (config.verbose) {
         std::cout << "Linear Regression training completed." << std::endl;
-        std::cout << "R²: " << r_squared << ", MSE: " << mse << std::endl;
+        if (metrics_computed) {
+            std::cout << "R²: " << r_squared << ", MSE: " << mse << std::endl;
+        }
     }
 }
 
 template<typename T>
-bool LinearRegression<T>::solveDirect(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
-    try {
-        Eigen::MatrixX<T> XTX = X.transpose() * X;
+template<typename Matrix>
+bool LinearRegression<T>::solve(const Matrix& X, const VectorRef<T>& y) {
+    // Ordem de tentativa: precisão mista -> direto -> SVD
+    if (config.mixed_precision && solveMixedPrecision(X, y)) {
+        return true;
+    }
+    if (config.mixed_precision && config.verbose) {
+        std::cout << "Mixed-precision solution failed, using direct solver..." << std::endl;
+    }
+    
+    if (!solveDirect(X, y)) {
+        if (config.verbose) {
+            std::cout << "Direct solution failed, using SVD fallback..." << std::endl;
+        }
+        return solveSVD(X, y);
+    }
+    return true;
+}
+
+template<typename T>
+template<typename Matrix>
+bool LinearRegression<T>::solveMixedPrecision(const Matrix& X, const VectorRef<T>& y) {
+    // Em float a fatoração já é de precisão simples: nada a refinar
+    if (!std::is_same<T, double>::value) {
+        return false;
+    }
+    
+    // Gram em float32 (GEMM ~2x mais rápido), acumulada por blocos de linhas
+    // convertidos num buffer fixo: sem cópia n x d de X ao lado da original
+    const int n = static_cast<int>(X.rows());
+    const int block = 1024;
+    Eigen::MatrixXf XTXf = Eigen::MatrixXf::Zero(X.cols(), X.cols());
+    {
+        Workspace::Scope scratch(this->workspace.get());
+        auto X_block = scratch.matrix<float>(std::min(block, n), X.cols());
+        for (int start = 0; start < n; start += block) {
+            int rows = std::min(block, n - start);
+            X_block.topRows(rows) = X.middleRows(start, rows).template cast<float>();
+            XTXf.selfadjointView<Eigen::Lower>().rankUpdate(X_block.topRows(rows).transpose());
+        }
+    }
+    
+    Eigen::LLT<Eigen::MatrixXf> llt(XTXf);
+    // O refinamento só converge se cond(X^T X) * eps_float << 1
+    if (llt.info() != Eigen::Success || llt.rcond() < 100 * std::numeric_limits<float>::epsilon()) {
+        return false;
+    }
+    
+    // Refinamento iterativo: resíduo das equações normais em float64 (O(nd)),
+    // correção resolvida com o fator float32 (O(d²))
+    XTy.noalias() = X.transpose() * y;
+    weights = llt.solve(XTy.template cast<float>()).template cast<T>();
+    
+    Eigen::VectorX<T> residual(y.size());
+    Eigen::VectorX<T> gradient(X.cols());
+    for (int step = 0; step < config.refinement_steps; ++step) {
+        residual = y;
+        residual.noalias() -= X * weights;
+        gradient.noalias() = X.transpose() * residual;
         
-        // Verifica se a matriz é invertível
-        Eigen::FullPivLU<Eigen::MatrixX<T>> lu(XTX);
-        if (!lu.isInvertible()) {
-            return false;
+        Eigen::VectorX<T> correction = llt.solve(gradient.template cast<float>()).template cast<T>();
+        weights += correction;
+        if (config.verbose) {
+            std::cout << "Refinement step " << step + 1 << ": |dw| = " << correction.norm() << std::endl;
         }
+        if (correction.norm() <= 4 * std::numeric_limits<T>::epsilon() * weights.norm()) {
+            break;
+        }
+    }
+    
+    // Métricas a partir do resíduo final (o Gram float não é exato o bastante)
+    residual = y;
+    residual.noalias() -= X * weights;
+    XTX = Eigen::MatrixXf(XTXf.selfadjointView<Eigen::Lower>()).template cast<T>();
+    yTy = y.squaredNorm();
+    y_sum = y.sum();
+    n_samples = y.size();
+    cached_rss = residual.squaredNorm();
+    has_cached_rss = true;
+    has_sufficient_stats = true;
+    return true;
+}
+
+template<typename T>
+template<typename Matrix>
+bool LinearRegression<T>::solveDirect(const Matrix& X, const VectorRef<T>& y) {
+    try {
+        // Guarda as estatísticas suficientes: as métricas saem delas em O(d²)
+        XTX.noalias() = X.transpose() * X;
+        XTy.noalias() = X.transpose() * y;
+        yTy = y.squaredNorm();
+        y_sum = y.sum();
+        n_samples = y.size();
+        has_sufficient_stats = true;
         
-        Eigen::MatrixX<T> XTX_inv = XTX.inverse();
-        weights = XTX_inv * X.transpose() * y;
-        return true;
+        return solveNormalEquations();
         
     } catch (const std::exception& e) {
         if (config.verbose) {
@@ -65,7 +154,159 @@ bool LinearRegression<T>::solveDirect(const Eigen::MatrixX<T>& X, const Eigen::V
 }
 
 template<typename T>
-bool LinearRegression<T>::solveSVD(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
+bool LinearRegression<T>::solveNormalEquations() {
+    // Verifica se a matriz é invertível
+    lu.compute(XTX);
+    if (!lu.isInvertible()) {
+        return false;
+    }
+    
+    // w = Q U^-1 L^-1 P X^T y, como lu.solve mas sem o temporário interno
+    Workspace::Scope scratch(this->workspace.get());
+    auto solution = scratch.vector<T>(XTy.size());
+    solution.noalias() = lu.permutationP() * XTy;
+    lu.matrixLU().template triangularView<Eigen::UnitLower>().solveInPlace(solution);
+    lu.matrixLU().template triangularView<Eigen::Upper>().solveInPlace(solution);
+    weights.resize(solution.size());
+    weights.noalias() = lu.permutationQ() * solution;
+    return true;
+}
+
+template<typename T>
+void LinearRegression<T>::trainFromNormalEquations(const MatrixRef<T>& gram, const VectorRef<T>& moment,
+                                                   T y_squared_norm, T y_total, long num_samples) {
+    if (gram.rows() != gram.cols() || gram.rows() != moment.size()) {
+        throw std::invalid_argument("X^T X must be square and match the size of X^T y");
+    }
+    
+    XTX = gram;
+    XTy = moment;
+    yTy = y_squared_norm;
+    y_sum = y_total;
+    n_samples = num_samples;
+    has_sufficient_stats = true;
+    has_cached_rss = false;
+    metrics_computed = false;
+    
+    if (!solveNormalEquations()) {
+        if (config.verbose) {
+            std::cout << "Direct solution failed, using pseudo-inverse fallback..." << std::endl;
+        }
+        // Sem X não há SVD: usa a pseudo-inversa das equações normais
+        weights = XTX.completeOrthogonalDecomposition().solve(XTy);
+    }
+    
+    if (config.metrics_mode != MetricsMode::Skip) {
+        calculateMetricsFromSufficientStats();
+    }
+    
+    if (config.verbose) {
+        std::cout << "Linear Regression training (normal equations) completed." << std::endl;
+        if (metrics_computed) {
+            std::cout << "R²: " << r_squared << ", MSE: " << mse << std::endl;
+        }
+    }
+}
+
+template<typename T>
+void LinearRegression<T>::trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) {
+    if (this->preprocessing_enabled) {
+        Model<T>::trainRowMajor(X, y);
+        return;
+    }
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    has_sufficient_stats = false;
+    has_cached_rss = false;
+    metrics_computed = false;
+    
+    solve(X, y);
+    updateTrainingMetrics(X, y);
+    
+    if (config.verbose) {
+        std::cout << "Linear Regression training (row-major) completed." << std::endl;
+        if (metrics_computed) {
+            std::cout << "R²: " << r_squared << ", MSE: " << mse << std::endl;
+        }
+    }
+}
+
+template<typename T>
+Eigen::VectorX<T> LinearRegression<T>::predictRowMajor(const RowMajorRef<T>& X) const {
+    return X * weights;
+}
+
+template<typename T>
+void LinearRegression<T>::trainWeighted(const MatrixRef<T>& X, const VectorRef<T>& y,
+                                        const VectorRef<T>& sample_weights) {
+    if (X.rows() != y.size() || sample_weights.size() != y.size()) {
+        throw std::invalid_argument("X, y and sample_weights must have the same number of rows");
+    }
+    
+    // Só o bloco W_b X_b é temporário; X inteira nunca é copiada
+    const int n = static_cast<int>(X.rows());
+    const int block = 256;
+    Workspace::Scope scratch(this->workspace.get());
+    auto gram = scratch.matrix<T>(X.cols(), X.cols());
+    auto weighted_block = scratch.matrix<T>(std::min(block, n), X.cols());
+    auto weighted_y = scratch.vector<T>(n);
+    auto moment = scratch.vector<T>(X.cols());
+    gram.setZero();
+    for (int start = 0; start < n; start += block) {
+        int rows = std::min(block, n - start);
+        weighted_block.topRows(rows).noalias() =
+            sample_weights.segment(start, rows).asDiagonal() * X.middleRows(start, rows);
+        gram.noalias() += X.middleRows(start, rows).transpose() * weighted_block.topRows(rows);
+    }
+    weighted_y = sample_weights.cwiseProduct(y);
+    moment.noalias() = X.transpose() * weighted_y;
+    
+    trainFromNormalEquations(gram, moment, weighted_y.dot(y), weighted_y.sum(),
+                             static_cast<long>(std::lround(static_cast<double>(sample_weights.sum()))));
+}
+
+template<typename T>
+void LinearRegression<T>::trainSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    has_sufficient_stats = false;
+    has_cached_rss = false;
+    metrics_computed = false;
+    
+    // Partindo de w = 0, o CG fica no espaço gerado pelas linhas de X:
+    // colunas de hash nunca vistas (e colineares) recebem peso nulo
+    Eigen::LeastSquaresConjugateGradient<Eigen::SparseMatrix<T, Eigen::RowMajor>> solver;
+    solver.setMaxIterations(config.max_iterations);
+    solver.setTolerance(config.tolerance);
+    solver.compute(X);
+    weights = solver.solve(y);
+    
+    if (config.metrics_mode != MetricsMode::Skip) {
+        calculateMetrics(X, y);
+    }
+    
+    if (config.verbose) {
+        std::cout << "Linear Regression training (sparse CG) completed: " << solver.iterations()
+                  << " iterations, estimated error: " << solver.error()
+                  << (solver.info() == Eigen::Success ? "" : " (not converged)") << std::endl;
+        if (metrics_computed) {
+            std::cout << "R²: " << r_squared << ", MSE: " << mse << std::endl;
+        }
+    }
+}
+
+template<typename T>
+Eigen::VectorX<T> LinearRegression<T>::predictSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X) const {
+    return X * weights;
+}
+
+template<typename T>
+bool LinearRegression<T>::solveSVD(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (config.randomized_svd) {
+        return solveRandomizedSVD(X, y);
+    }
     try {
         // Usa SVD para solução numericamente estável
         Eigen::JacobiSVD<Eigen::MatrixX<T>> svd(X, Eigen::ComputeThinU | Eigen::ComputeThinV);
@@ -84,10 +325,36 @@ bool LinearRegression<T>::solveSVD(const Eigen::MatrixX<T>& X, const Eigen::Vect
 }
 
 template<typename T>
-Eigen::VectorX<T> LinearRegression<T>::predict(const Eigen::MatrixX<T>& X) const {
+bool LinearRegression<T>::solveRandomizedSVD(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    const int d = static_cast<int>(X.cols());
+    const int rank = config.svd_rank > 0 ? std::min(config.svd_rank, d) : d;
+    TruncatedSVD<T> svd = RandomizedSVD<T>(rank, 10, 2, config.seed).computeDirect(X);
+    
+    // w = V S^-1 U^T y, com o corte da JacobiSVD: max(n, d) eps S_max. A faixa
+    // vem de X (não de X^T X), então o condicionamento não é elevado ao quadrado
+    const T threshold = (svd.S.size() > 0 ? svd.S(0) : static_cast<T>(0)) *
+                        static_cast<T>(std::max(X.rows(), X.cols())) * std::numeric_limits<T>::epsilon();
+    Eigen::VectorX<T> inverse = svd.S.unaryExpr([threshold](T s) {
+        return s > threshold ? static_cast<T>(1) / s : static_cast<T>(0);
+    });
+    Eigen::VectorX<T> projected = svd.U.transpose() * y;
+    weights = svd.V * inverse.asDiagonal() * projected;
+    return true;
+}
+
+template<typename T>
+Eigen::VectorX<T> LinearRegression<T>::predict(const MatrixRef<T>& X) const {
     return X * weights;
 }
 
+template<typename T>
+void LinearRegression<T>::predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const {
+    if (out.size() != X.rows()) {
+        throw std::invalid_argument("Output size must match the number of rows of X");
+    }
+    out.noalias() = X * weights;
+}
+
 template<typename T>
 void LinearRegression<T>::saveWeights(const std::string& filename) const {
     std::ofstream file(filename, std::ios::binary);
@@ -116,20 +383,89 @@ void LinearRegression<T>::loadWeights(const std::string& filename) {
 }
 
 template<typename T>
-void LinearRegression<T>::calculateMetrics(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
-    Eigen::VectorX<T> predictions = predict(X);
-    Eigen::VectorX<T> residuals = y - predictions;
+template<typename Matrix>
+void LinearRegression<T>::calculateMetrics(const Matrix& X, const VectorRef<T>& y) {
+    Workspace::Scope scratch(this->workspace.get());
+    auto residuals = scratch.vector<T>(y.size());
+    residuals = y;
+    residuals.noalias() -= X * weights;
+    T rss = residuals.squaredNorm();
     
     // MSE
-    mse = residuals.squaredNorm() / static_cast<T>(y.size());
+    mse = rss / static_cast<T>(y.size());
     
     // R²
     T total_variance = (y.array() - y.mean()).square().sum();
-    T explained_variance = total_variance - residuals.squaredNorm();
+    T explained_variance = total_variance - rss;
     r_squared = (total_variance > static_cast<T>(1e-10)) ? 
                 explained_variance / total_variance : static_cast<T>(0);
+    metrics_computed = true;
+}
+
+template<typename T>
+bool LinearRegression<T>::calculateMetricsFromSufficientStats() {
+    if (!has_sufficient_stats || n_samples == 0 || XTy.size() != weights.size()) {
+        return false;
+    }
+    
+    // RSS = y^T y - 2 w^T X^T y + w^T X^T X w, sem tocar em X.
+    // Acumulado em double para reduzir o cancelamento quando o ajuste é bom.
+    double rss;
+    if (has_cached_rss) {
+        rss = static_cast<double>(cached_rss);
+    } else {
+        const Eigen::Index d = weights.size();
+        Workspace::Scope scratch(this->workspace.get());
+        auto w = scratch.vector<double>(d);
+        auto gram = scratch.matrix<double>(d, d);
+        auto gram_w = scratch.vector<double>(d);
+        w = weights.template cast<double>();
+        gram = XTX.template cast<double>();
+        gram_w.noalias() = gram * w;
+        double quadratic = w.dot(gram_w);
+        rss = std::max(0.0, static_cast<double>(yTy) - 2.0 * w.dot(XTy.template cast<double>()) + quadratic);
+    }
+    double n = static_cast<double>(n_samples);
+    double total_variance = static_cast<double>(yTy) - static_cast<double>(y_sum) * static_cast<double>(y_sum) / n;
+    
+    mse = static_cast<T>(rss / n);
+    r_squared = (total_variance > 1e-10) ? static_cast<T>((total_variance - rss) / total_variance) : static_cast<T>(0);
+    metrics_computed = true;
+    return true;
+}
+
+template<typename T>
+template<typename Matrix>
+void LinearRegression<T>::updateTrainingMetrics(const Matrix& X, const VectorRef<T>& y) {
+    switch (config.metrics_mode) {
+        case MetricsMode::Skip:
+            metrics_computed = false;
+            break;
+        case MetricsMode::Auto:
+            // Em float, y^T y - 2 w^T X^T y + w^T X^T X w sobre estatísticas
+            // acumuladas em float sofre cancelamento catastrófico: passada nos dados
+            if (std::is_same<T, double>::value && calculateMetricsFromSufficientStats()) {
+                break;
+            }
+            calculateMetrics(X, y);
+            break;
+        case MetricsMode::DataPass:
+            calculateMetrics(X, y);
+            break;
+    }
+}
+
+template<typename T>
+void LinearRegression<T>::computeMetrics(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    calculateMetrics(X, y);
 }
 
 // Instanciações explícitas
 template class LinearRegression<float>;
-template class LinearRegression<double>;
\ No newline at end of file
+template class LinearRegression<double>;
+// Usada também pela OnlineLinearRegression
+template void LinearRegression<float>::updateTrainingMetrics(const MatrixRef<float>&, const VectorRef<float>&);
+template void LinearRegression<double>::updateTrainingMetrics(const MatrixRef<double>&, const VectorRef<double>&);
\ No newline at end of file
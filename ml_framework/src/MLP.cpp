@@ -0,0 +1,420 @@
+// src/MLP.cpp
+#include "../include/MLP.h"
+#include "../include/ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// Bias + ativação aplicados numa única passada sobre a saída do GEMM
+template<typename T>
+void applyBiasActivation(Eigen::Ref<Eigen::MatrixX<T>> out, const Eigen::VectorX<T>& bias, Activation activation) {
+    switch (activation) {
+        case Activation::Identity:
+            out.rowwise() += bias.transpose();
+            break;
+        case Activation::ReLU:
+            out = (out.rowwise() + bias.transpose()).cwiseMax(static_cast<T>(0));
+            break;
+        case Activation::Sigmoid:
+            out = (static_cast<T>(1) + (-(out.rowwise() + bias.transpose()).array()).exp()).inverse().matrix();
+            break;
+        case Activation::Tanh:
+            out = (out.rowwise() + bias.transpose()).array().tanh().matrix();
+            break;
+    }
+}
+
+// delta *= f'(z), escrita em função da saída a = f(z)
+template<typename T>
+void applyActivationDerivative(Eigen::Ref<Eigen::MatrixX<T>> delta, const Eigen::Ref<const Eigen::MatrixX<T>>& a,
+                               Activation activation) {
+    switch (activation) {
+        case Activation::Identity:
+            break;
+        case Activation::ReLU:
+            delta = (a.array() > static_cast<T>(0)).select(delta, static_cast<T>(0));
+            break;
+        case Activation::Sigmoid:
+            delta.array() *= a.array() * (static_cast<T>(1) - a.array());
+            break;
+        case Activation::Tanh:
+            delta.array() *= static_cast<T>(1) - a.array().square();
+            break;
+    }
+}
+
+// Softmax estável por linha (subtrai o máximo antes da exponencial)
+template<typename T>
+void applySoftmax(Eigen::Ref<Eigen::MatrixX<T>> out) {
+    for (int i = 0; i < out.rows(); ++i) {
+        T max_value = out.row(i).maxCoeff();
+        out.row(i) = (out.row(i).array() - max_value).exp().matrix();
+        out.row(i) /= out.row(i).sum();
+    }
+}
+
+} // namespace
+
+template<typename T>
+MLP<T>::MLP(const std::vector<int>& layer_sizes, Activation hidden_activation, Activation output_activation)
+    : MLP(layer_sizes, TrainingConfig<T>(), hidden_activation, output_activation) {}
+
+template<typename T>
+MLP<T>::MLP(const std::vector<int>& layer_sizes, const TrainingConfig<T>& config,
+            Activation hidden_activation, Activation output_activation)
+    : layer_sizes(layer_sizes), hidden_activation(hidden_activation),
+      output_activation(output_activation), config(config) {
+    if (layer_sizes.size() < 2) {
+        throw std::invalid_argument("MLP needs at least an input and an output layer");
+    }
+    for (int size : layer_sizes) {
+        if (size <= 0) {
+            throw std::invalid_argument("MLP layer sizes must be positive");
+        }
+    }
+    initializeWeights();
+}
+
+template<typename T>
+void MLP<T>::initializeWeights() {
+    std::mt19937 rng(config.seed);
+    const int L = static_cast<int>(layer_sizes.size()) - 1;
+    W.resize(L);
+    b.resize(L);
+
+    for (int l = 0; l < L; ++l) {
+        int fan_in = layer_sizes[l];
+        int fan_out = layer_sizes[l + 1];
+        // He para ReLU, Xavier para as demais ativações
+        T scale = std::sqrt(static_cast<T>(hidden_activation == Activation::ReLU && l < L - 1 ? 2 : 1) /
+                            static_cast<T>(fan_in));
+        std::normal_distribution<T> dist(0, scale);
+
+        W[l].resize(fan_in, fan_out);
+        for (int j = 0; j < fan_out; ++j) {
+            for (int i = 0; i < fan_in; ++i) {
+                W[l](i, j) = dist(rng);
+            }
+        }
+        b[l] = Eigen::VectorX<T>::Zero(fan_out);
+    }
+}
+
+template<typename T>
+void MLP<T>::allocateBuffers(int batch_size) {
+    if (batch_size == buffer_batch_size) {
+        return;
+    }
+
+    const int L = numLayers();
+    activations.resize(L);
+    deltas.resize(L);
+    for (int l = 0; l < L; ++l) {
+        activations[l].resize(batch_size, layer_sizes[l + 1]);
+        deltas[l].resize(batch_size, layer_sizes[l + 1]);
+    }
+    buffer_batch_size = batch_size;
+}
+
+template<typename T>
+void MLP<T>::resetOptimizerState() {
+    const int L = numLayers();
+    grad_W.resize(L);
+    grad_b.resize(L);
+    m_W.resize(L);
+    v_W.resize(L);
+    m_b.resize(L);
+    v_b.resize(L);
+
+    for (int l = 0; l < L; ++l) {
+        grad_W[l] = Eigen::MatrixX<T>::Zero(W[l].rows(), W[l].cols());
+        grad_b[l] = Eigen::VectorX<T>::Zero(b[l].size());
+        if (config.optimizer == OptimizerType::Adam) {
+            m_W[l] = Eigen::MatrixX<T>::Zero(W[l].rows(), W[l].cols());
+            v_W[l] = Eigen::MatrixX<T>::Zero(W[l].rows(), W[l].cols());
+            m_b[l] = Eigen::VectorX<T>::Zero(b[l].size());
+            v_b[l] = Eigen::VectorX<T>::Zero(b[l].size());
+        }
+    }
+    adam_step = 0;
+}
+
+template<typename T>
+void MLP<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (this->preprocessing_enabled) {
+        Eigen::MatrixX<T> X_processed = X;
+        Eigen::VectorX<T> y_processed = y;
+        this->preprocessData(X_processed, y_processed);
+        MatrixBatchSource<T> source(X_processed, y_processed);
+        trainFromSource(source);
+    } else {
+        MatrixBatchSource<T> source(X, y);
+        trainFromSource(source);
+    }
+}
+
+template<typename T>
+void MLP<T>::trainFromSource(BatchSource<T>& source) {
+    if (source.numFeatures() != layer_sizes.front()) {
+        throw std::invalid_argument("Source features do not match the MLP input layer");
+    }
+    // Threads do Eigen só durante o treino; o valor anterior volta na saída
+    EigenThreadsGuard eigen_threads(config.num_threads > 0 ? config.num_threads : Eigen::nbThreads());
+
+    const int batch_size = std::max(1, config.batch_size);
+
+    initializeWeights();
+    allocateBuffers(batch_size);
+    resetOptimizerState();
+    loss_history.clear();
+
+    // Enquanto o modelo processa um batch, a thread do pipeline reúne o próximo
+    MiniBatchPipeline<T> pipeline(source, batch_size, config.seed, true);
+
+    for (int epoch = 0; epoch < config.epochs; ++epoch) {
+        pipeline.startEpoch();
+        T epoch_loss = 0;
+        long seen = 0;
+
+        while (pipeline.next()) {
+            int rows = pipeline.batchRows();
+            auto input = pipeline.batchX().topRows(rows);
+            auto targets = pipeline.batchY().head(rows);
+
+            forward(input, activations);
+            epoch_loss += backward(input, targets) * static_cast<T>(rows);
+            optimizerStep();
+            seen += rows;
+        }
+
+        if (seen == 0) {
+            throw std::invalid_argument("Training source produced no samples");
+        }
+        loss_history.push_back(epoch_loss / static_cast<T>(seen));
+        if (config.verbose) {
+            std::cout << "Epoch " << epoch + 1 << "/" << config.epochs
+                      << " - loss: " << loss_history.back() << std::endl;
+        }
+    }
+}
+
+template<typename T>
+void MLP<T>::forward(const InputRef& input, std::vector<Eigen::MatrixX<T>>& acts) const {
+    const int L = numLayers();
+    const Eigen::Index rows = input.rows();
+    for (int l = 0; l < L; ++l) {
+        auto out = acts[l].topRows(rows);
+        if (l == 0) {
+            out.noalias() = input * W[l];
+        } else {
+            out.noalias() = acts[l - 1].topRows(rows) * W[l];
+        }
+
+        if (l == L - 1 && isSoftmaxOutput()) {
+            out.rowwise() += b[l].transpose();
+            applySoftmax<T>(out);
+        } else {
+            applyBiasActivation<T>(out, b[l], l == L - 1 ? output_activation : hidden_activation);
+        }
+    }
+}
+
+template<typename T>
+T MLP<T>::backward(const InputRef& input, const Eigen::Ref<const Eigen::VectorX<T>>& y_batch) {
+    const int L = numLayers();
+    const Eigen::Index rows = input.rows();
+    const T inv_rows = static_cast<T>(1) / static_cast<T>(rows);
+    auto output = activations[L - 1].topRows(rows);
+    auto delta_out = deltas[L - 1].topRows(rows);
+    T loss = 0;
+
+    if (isSoftmaxOutput()) {
+        // Softmax + entropia cruzada: dL/dz = (p - onehot) / m
+        delta_out = output;
+        for (Eigen::Index i = 0; i < rows; ++i) {
+            int label = static_cast<int>(y_batch(i));
+            if (y_batch(i) != static_cast<T>(label) || label < 0 || label >= layer_sizes.back()) {
+                throw std::invalid_argument("Class labels must be integers in [0, output_size)");
+            }
+            loss -= std::log(std::max(output(i, label), std::numeric_limits<T>::min()));
+            delta_out(i, label) -= 1;
+        }
+        delta_out *= inv_rows;
+    } else {
+        // MSE: dL/dz = 2 (a - y) f'(z) / m
+        delta_out.col(0) = output.col(0) - y_batch;
+        loss = delta_out.col(0).squaredNorm();
+        delta_out *= 2 * inv_rows;
+        applyActivationDerivative<T>(delta_out, output, output_activation);
+    }
+
+    for (int l = L - 1; l >= 0; --l) {
+        auto delta = deltas[l].topRows(rows);
+        if (l == 0) {
+            grad_W[l].noalias() = input.transpose() * delta;
+        } else {
+            grad_W[l].noalias() = activations[l - 1].topRows(rows).transpose() * delta;
+        }
+        grad_b[l].noalias() = delta.colwise().sum().transpose();
+
+        if (l > 0) {
+            auto delta_prev = deltas[l - 1].topRows(rows);
+            delta_prev.noalias() = delta * W[l].transpose();
+            applyActivationDerivative<T>(delta_prev, activations[l - 1].topRows(rows), hidden_activation);
+        }
+    }
+
+    return loss * inv_rows;
+}
+
+template<typename T>
+void MLP<T>::optimizerStep() {
+    const int L = numLayers();
+    const T lr = config.learning_rate;
+
+    if (config.optimizer == OptimizerType::SGD) {
+        for (int l = 0; l < L; ++l) {
+            W[l].noalias() -= lr * grad_W[l];
+            b[l].noalias() -= lr * grad_b[l];
+        }
+        return;
+    }
+
+    ++adam_step;
+    const T beta1 = config.adam_beta1;
+    const T beta2 = config.adam_beta2;
+    const T eps = config.adam_epsilon;
+    const T step = lr * std::sqrt(1 - std::pow(beta2, static_cast<T>(adam_step))) /
+                   (1 - std::pow(beta1, static_cast<T>(adam_step)));
+
+    for (int l = 0; l < L; ++l) {
+        m_W[l] = beta1 * m_W[l] + (1 - beta1) * grad_W[l];
+        v_W[l] = beta2 * v_W[l] + (1 - beta2) * grad_W[l].cwiseAbs2();
+        W[l].array() -= step * m_W[l].array() / (v_W[l].array().sqrt() + eps);
+
+        m_b[l] = beta1 * m_b[l] + (1 - beta1) * grad_b[l];
+        v_b[l] = beta2 * v_b[l] + (1 - beta2) * grad_b[l].cwiseAbs2();
+        b[l].array() -= step * m_b[l].array() / (v_b[l].array().sqrt() + eps);
+    }
+}
+
+template<typename T>
+Eigen::MatrixX<T> MLP<T>::predictRaw(const MatrixRef<T>& X) const {
+    if (X.cols() != layer_sizes.front()) {
+        throw std::invalid_argument("X columns do not match the MLP input layer");
+    }
+
+    const int n = static_cast<int>(X.rows());
+    const int chunk = std::max(1, std::min(std::max(config.batch_size, 256), n));
+    const int L = numLayers();
+
+    std::vector<Eigen::MatrixX<T>> acts(L);
+    for (int l = 0; l < L; ++l) {
+        acts[l].resize(chunk, layer_sizes[l + 1]);
+    }
+
+    // Blocos de linhas de X entram direto no primeiro GEMM, sem cópia
+    Eigen::MatrixX<T> output(n, layer_sizes.back());
+    for (int start = 0; start < n; start += chunk) {
+        int rows = std::min(chunk, n - start);
+        forward(X.middleRows(start, rows), acts);
+        output.middleRows(start, rows) = acts[L - 1].topRows(rows);
+    }
+    return output;
+}
+
+template<typename T>
+Eigen::VectorX<T> MLP<T>::predict(const MatrixRef<T>& X) const {
+    Eigen::MatrixX<T> raw = predictRaw(X);
+    if (!isSoftmaxOutput()) {
+        return raw.col(0);
+    }
+
+    Eigen::VectorX<T> classes(raw.rows());
+    for (int i = 0; i < raw.rows(); ++i) {
+        Eigen::Index label;
+        raw.row(i).maxCoeff(&label);
+        classes(i) = static_cast<T>(label);
+    }
+    return classes;
+}
+
+template<typename T>
+int MLP<T>::getParameterCount() const {
+    int count = 0;
+    for (int l = 0; l < numLayers(); ++l) {
+        count += static_cast<int>(W[l].size() + b[l].size());
+    }
+    return count;
+}
+
+template<typename T>
+Eigen::VectorX<T> MLP<T>::getWeights() const {
+    Eigen::VectorX<T> flat(getParameterCount());
+    int offset = 0;
+    for (int l = 0; l < numLayers(); ++l) {
+        flat.segment(offset, W[l].size()) = Eigen::Map<const Eigen::VectorX<T>>(W[l].data(), W[l].size());
+        offset += static_cast<int>(W[l].size());
+        flat.segment(offset, b[l].size()) = b[l];
+        offset += static_cast<int>(b[l].size());
+    }
+    return flat;
+}
+
+template<typename T>
+void MLP<T>::setWeights(const Eigen::VectorX<T>& new_weights) {
+    if (new_weights.size() != getParameterCount()) {
+        throw std::invalid_argument("Weight vector size does not match the MLP architecture");
+    }
+
+    int offset = 0;
+    for (int l = 0; l < numLayers(); ++l) {
+        Eigen::Map<Eigen::VectorX<T>>(W[l].data(), W[l].size()) = new_weights.segment(offset, W[l].size());
+        offset += static_cast<int>(W[l].size());
+        b[l] = new_weights.segment(offset, b[l].size());
+        offset += static_cast<int>(b[l].size());
+    }
+}
+
+template<typename T>
+void MLP<T>::saveWeights(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    Eigen::VectorX<T> flat = getWeights();
+    int size = flat.size();
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(flat.data()), size * sizeof(T));
+    file.close();
+}
+
+template<typename T>
+void MLP<T>::loadWeights(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    int size;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    if (size != getParameterCount()) {
+        throw std::runtime_error("Weight file does not match the MLP architecture: " + filename);
+    }
+    Eigen::VectorX<T> flat(size);
+    file.read(reinterpret_cast<char*>(flat.data()), size * sizeof(T));
+    file.close();
+    setWeights(flat);
+}
+
+// Instanciações explícitas
+template class MLP<float>;
+template class MLP<double>;
@@ -4,7 +4,7 @@
 
 template<typename T>
 ClassificationMetrics<T> Metrics<T>::calculateClassificationMetrics(
-    const Eigen::VectorX<T>& y_true, const Eigen::VectorX<T>& y_pred) {
+    const Eigen::Ref<const Eigen::VectorX<T>>& y_true, const Eigen::Ref<const Eigen::VectorX<T>>& y_pred) {
     
     ClassificationMetrics<T> metrics;
     
@@ -36,7 +36,8 @@ ClassificationMetrics<T> Metrics<T>::calculateClassificationMetrics(
 }
 
 template<typename T>
-T Metrics<T>::calculateAccuracy(const Eigen::VectorX<T>& y_true, const Eigen::VectorX<T>& y_pred) {
+T Metrics<T>::calculateAccuracy(const Eigen::Ref<const Eigen::VectorX<T>>& y_true,
+                                const Eigen::Ref<const Eigen::VectorX<T>>& y_pred) {
     // CORREÇÃO: usar abordagem sem template cast
     int correct = 0;
     for (int i = 0; i < y_true.size(); ++i) {
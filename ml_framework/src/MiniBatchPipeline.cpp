@@ -0,0 +1,301 @@
+// src/MiniBatchPipeline.cpp
+#include "../include/MiniBatchPipeline.h"
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+// ---------------------------------------------------------------------------
+// MatrixBatchSource
+
+template<typename T>
+void MatrixBatchSource<T>::initialize() {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    std::iota(permutation.begin(), permutation.end(), 0);
+}
+
+template<typename T>
+void MatrixBatchSource<T>::beginEpoch(std::mt19937& rng, bool shuffle) {
+    if (shuffle) {
+        std::shuffle(permutation.begin(), permutation.end(), rng);
+    }
+    cursor = 0;
+}
+
+template<typename T>
+int MatrixBatchSource<T>::fill(Eigen::MatrixX<T>& X_buffer, Eigen::VectorX<T>& y_buffer, int max_rows) {
+    int rows = std::min(max_rows, static_cast<int>(permutation.size()) - cursor);
+    for (int r = 0; r < rows; ++r) {
+        int index = permutation[cursor + r];
+        X_buffer.row(r) = X.row(index);
+        y_buffer(r) = y(index);
+    }
+    cursor += rows;
+    return rows;
+}
+
+// ---------------------------------------------------------------------------
+// CsvBatchSource
+
+template<typename T>
+CsvBatchSource<T>::CsvBatchSource(const std::string& filename, char delimiter, int label_column,
+                                  bool has_header, int shuffle_buffer_rows, T feature_scale)
+    : file(filename), filename(filename), delimiter(delimiter), label_column(label_column),
+      has_header(has_header), feature_scale(feature_scale) {
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+    if (shuffle_buffer_rows <= 0) {
+        throw std::invalid_argument("shuffle_buffer_rows must be positive");
+    }
+
+    if (has_header) {
+        std::getline(file, line);
+    }
+    data_start = file.tellg();
+
+    // Conta as colunas na primeira linha de dados
+    while (std::getline(file, line) && line.empty()) {}
+    if (line.empty()) {
+        throw std::runtime_error("No data rows in file: " + filename);
+    }
+    num_features = static_cast<int>(std::count(line.begin(), line.end(), delimiter));
+    if (label_column < 0 || label_column > num_features) {
+        throw std::invalid_argument("label_column out of range for file: " + filename);
+    }
+
+    block_X.resize(shuffle_buffer_rows, num_features);
+    block_y.resize(shuffle_buffer_rows);
+    block_order.reserve(shuffle_buffer_rows);
+
+    file.clear();
+    file.seekg(data_start);
+}
+
+template<typename T>
+void CsvBatchSource<T>::beginEpoch(std::mt19937& rng, bool shuffle) {
+    file.clear();
+    file.seekg(data_start);
+    this->rng = &rng;
+    this->shuffle = shuffle;
+    block_rows = 0;
+    block_cursor = 0;
+}
+
+template<typename T>
+bool CsvBatchSource<T>::parseLine(const std::string& text, int row) {
+    const char* p = text.c_str();
+    int column = 0;
+    int feature = 0;
+
+    while (true) {
+        char* end;
+        T value = static_cast<T>(std::strtod(p, &end));
+        if (end == p) {
+            return false;
+        }
+
+        if (column == label_column) {
+            block_y(row) = value;
+        } else {
+            if (feature >= num_features) {
+                return false;
+            }
+            block_X(row, feature++) = value * feature_scale;
+        }
+        ++column;
+
+        p = end;
+        while (*p == ' ' || *p == '\r') ++p;
+        if (*p == delimiter) {
+            ++p;
+        } else if (*p == '\0') {
+            break;
+        } else {
+            return false;
+        }
+    }
+    return feature == num_features;
+}
+
+template<typename T>
+void CsvBatchSource<T>::readBlock() {
+    const int capacity = static_cast<int>(block_X.rows());
+    block_rows = 0;
+    while (block_rows < capacity && std::getline(file, line)) {
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        if (!parseLine(line, block_rows)) {
+            throw std::runtime_error("Malformed data row in file: " + filename);
+        }
+        ++block_rows;
+    }
+
+    block_order.resize(block_rows);
+    std::iota(block_order.begin(), block_order.end(), 0);
+    if (shuffle && rng != nullptr) {
+        std::shuffle(block_order.begin(), block_order.end(), *rng);
+    }
+    block_cursor = 0;
+}
+
+template<typename T>
+int CsvBatchSource<T>::fill(Eigen::MatrixX<T>& X_buffer, Eigen::VectorX<T>& y_buffer, int max_rows) {
+    int rows = 0;
+    while (rows < max_rows) {
+        if (block_cursor == block_rows) {
+            readBlock();
+            if (block_rows == 0) {
+                break;
+            }
+        }
+        int index = block_order[block_cursor++];
+        X_buffer.row(rows) = block_X.row(index);
+        y_buffer(rows) = block_y(index);
+        ++rows;
+    }
+    return rows;
+}
+
+// ---------------------------------------------------------------------------
+// MiniBatchPipeline
+
+template<typename T>
+MiniBatchPipeline<T>::MiniBatchPipeline(BatchSource<T>& source, int batch_size, unsigned int seed, bool shuffle)
+    : source(source), batch_size(batch_size), shuffle(shuffle), rng(seed) {
+    if (batch_size <= 0) {
+        throw std::invalid_argument("batch_size must be positive");
+    }
+    for (Buffer& buffer : buffers) {
+        buffer.X.resize(batch_size, source.numFeatures());
+        buffer.y.resize(batch_size);
+    }
+    worker = std::thread(&MiniBatchPipeline<T>::producerLoop, this);
+}
+
+template<typename T>
+MiniBatchPipeline<T>::~MiniBatchPipeline() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stop = true;
+        abort_epoch = true;
+    }
+    cv.notify_all();
+    worker.join();
+}
+
+template<typename T>
+void MiniBatchPipeline<T>::producerLoop() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cv.wait(lock, [this] { return stop || epoch_active; });
+        if (stop) {
+            return;
+        }
+        producer_idle = false;
+
+        int k = 0;
+        while (true) {
+            cv.wait(lock, [this, k] { return stop || abort_epoch || buffers[k].state == BufferState::Free; });
+            if (stop || abort_epoch) {
+                break;
+            }
+
+            // Preenche fora do lock: o consumidor só lê buffers InUse
+            lock.unlock();
+            int rows = 0;
+            std::exception_ptr error;
+            try {
+                rows = source.fill(buffers[k].X, buffers[k].y, batch_size);
+            } catch (...) {
+                error = std::current_exception();
+            }
+            lock.lock();
+
+            if (error) {
+                worker_error = error;
+                rows = 0;
+            }
+            buffers[k].rows = rows;
+            buffers[k].state = BufferState::Ready;
+            cv.notify_all();
+
+            if (rows == 0) {
+                break; // marcador de fim de época
+            }
+            k ^= 1;
+        }
+
+        epoch_active = false;
+        producer_idle = true;
+        cv.notify_all();
+    }
+}
+
+template<typename T>
+void MiniBatchPipeline<T>::startEpoch() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    // Interrompe a época anterior caso o consumidor não a tenha esgotado
+    abort_epoch = true;
+    cv.notify_all();
+    cv.wait(lock, [this] { return producer_idle && !epoch_active; });
+    abort_epoch = false;
+
+    for (Buffer& buffer : buffers) {
+        buffer.state = BufferState::Free;
+        buffer.rows = 0;
+    }
+    current = -1;
+    consumer_next = 0;
+    worker_error = nullptr;
+
+    source.beginEpoch(rng, shuffle);
+    epoch_active = true;
+    cv.notify_all();
+}
+
+template<typename T>
+bool MiniBatchPipeline<T>::next() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (current >= 0) {
+        buffers[current].state = BufferState::Free;
+        current = -1;
+        cv.notify_all();
+    }
+
+    // Sem época em andamento e nada pronto: nada a consumir
+    if (!epoch_active && buffers[consumer_next].state != BufferState::Ready) {
+        return false;
+    }
+    cv.wait(lock, [this] { return buffers[consumer_next].state == BufferState::Ready; });
+
+    Buffer& buffer = buffers[consumer_next];
+    if (buffer.rows == 0) {
+        buffer.state = BufferState::Free;
+        cv.notify_all();
+        if (worker_error) {
+            std::exception_ptr error = worker_error;
+            worker_error = nullptr;
+            std::rethrow_exception(error);
+        }
+        return false;
+    }
+
+    buffer.state = BufferState::InUse;
+    current = consumer_next;
+    consumer_next ^= 1;
+    return true;
+}
+
+// Instanciações explícitas
+template class MatrixBatchSource<float>;
+template class MatrixBatchSource<double>;
+template class CsvBatchSource<float>;
+template class CsvBatchSource<double>;
+template class MiniBatchPipeline<float>;
+template class MiniBatchPipeline<double>;
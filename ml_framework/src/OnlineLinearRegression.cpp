@@ -0,0 +1,223 @@
+// src/OnlineLinearRegression.cpp
+#include "../include/OnlineLinearRegression.h"
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+
+template<typename T>
+OnlineLinearRegression<T>::OnlineLinearRegression() : LinearRegression<T>() {}
+
+template<typename T>
+OnlineLinearRegression<T>::OnlineLinearRegression(const TrainingConfig<T>& config)
+    : LinearRegression<T>(config) {}
+
+template<typename T>
+void OnlineLinearRegression<T>::reset(int num_features) {
+    if (this->config.forgetting_factor <= 0 || this->config.forgetting_factor > 1) {
+        throw std::invalid_argument("forgetting_factor must be in (0, 1]");
+    }
+
+    P = Eigen::MatrixX<T>::Identity(num_features, num_features) * this->config.rls_initial_variance;
+    Px = Eigen::VectorX<T>::Zero(num_features);
+    this->weights = Eigen::VectorX<T>::Zero(num_features);
+
+    int window = std::max(this->config.window_size, 0);
+    window_X.resize(window, num_features);
+    window_y.resize(window);
+    window_head = 0;
+    window_count = 0;
+    samples_seen = 0;
+}
+
+template<typename T>
+void OnlineLinearRegression<T>::update(const SampleRef& x, T y) {
+    if (P.rows() != x.size()) {
+        if (samples_seen != 0) {
+            throw std::invalid_argument("Sample size does not match the number of features");
+        }
+        reset(static_cast<int>(x.size()));
+    }
+
+    const T lambda = this->config.forgetting_factor;
+
+    // Sherman–Morrison: A' = lambda*A + x x^T
+    //   P' = (P - Px Px^T / (lambda + x^T P x)) / lambda
+    //   w' = w + Px * e / (lambda + x^T P x)
+    Px.noalias() = P.template selfadjointView<Eigen::Lower>() * x;
+    T denom = lambda + x.dot(Px);
+    T error = y - x.dot(this->weights);
+
+    this->weights.noalias() += (error / denom) * Px;
+    P.template selfadjointView<Eigen::Lower>().rankUpdate(Px, -1 / denom);
+    if (lambda != 1) {
+        P.template triangularView<Eigen::Lower>() *= 1 / lambda;
+    }
+    ++samples_seen;
+
+    if (window_X.rows() == 0) {
+        return;
+    }
+
+    // Janela cheia: remove a amostra mais antiga e reaproveita sua posição
+    bool stable = true;
+    int slot;
+    if (window_count == window_X.rows()) {
+        stable = removeOldest();
+        slot = window_head;
+        window_head = (window_head + 1) % static_cast<int>(window_X.rows());
+    } else {
+        slot = (window_head + window_count) % static_cast<int>(window_X.rows());
+        ++window_count;
+    }
+    window_X.row(slot) = x.transpose();
+    window_y(slot) = y;
+
+    if (!stable) {
+        rebuildFromWindow();
+    }
+}
+
+template<typename T>
+bool OnlineLinearRegression<T>::removeOldest() {
+    // Peso efetivo da amostra mais antiga após window_size passos de esquecimento
+    const T c = std::pow(this->config.forgetting_factor, static_cast<T>(window_X.rows()));
+    auto x = window_X.row(window_head).transpose();
+
+    // Downdate: A' = A - c x x^T
+    //   P' = P + c Px Px^T / (1 - c x^T P x)
+    //   w' = w - c Px * e / (1 - c x^T P x)
+    Px.noalias() = P.template selfadjointView<Eigen::Lower>() * x;
+    T denom = 1 - c * x.dot(Px);
+    if (denom <= std::numeric_limits<T>::epsilon()) {
+        return false;
+    }
+
+    T error = window_y(window_head) - x.dot(this->weights);
+    this->weights.noalias() -= (c * error / denom) * Px;
+    P.template selfadjointView<Eigen::Lower>().rankUpdate(Px, c / denom);
+    return true;
+}
+
+template<typename T>
+void OnlineLinearRegression<T>::rebuildFromWindow() {
+    // Recalcula P e w a partir do conteúdo da janela quando o downdate
+    // perde a positividade (caso raro, custo O(W d²))
+    const int d = static_cast<int>(P.rows());
+    const int capacity = static_cast<int>(window_X.rows());
+    const T lambda = this->config.forgetting_factor;
+
+    Eigen::MatrixX<T> A = Eigen::MatrixX<T>::Identity(d, d) / this->config.rls_initial_variance;
+    Eigen::VectorX<T> b = Eigen::VectorX<T>::Zero(d);
+    for (int k = 0; k < window_count; ++k) {
+        int idx = (window_head + k) % capacity;
+        T c = std::pow(lambda, static_cast<T>(window_count - 1 - k));
+        A.noalias() += c * window_X.row(idx).transpose() * window_X.row(idx);
+        b.noalias() += c * window_y(idx) * window_X.row(idx).transpose();
+    }
+
+    Eigen::LDLT<Eigen::MatrixX<T>> ldlt(A);
+    P = ldlt.solve(Eigen::MatrixX<T>::Identity(d, d));
+    this->weights = P * b;
+
+    if (this->config.verbose) {
+        std::cout << "RLS downdate lost positivity, rebuilt from window." << std::endl;
+    }
+}
+
+template<typename T>
+void OnlineLinearRegression<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+
+    if (this->preprocessing_enabled) {
+        Eigen::MatrixX<T> X_processed = X;
+        Eigen::VectorX<T> y_processed = y;
+        this->preprocessData(X_processed, y_processed);
+
+        reset(static_cast<int>(X_processed.cols()));
+        for (int i = 0; i < X_processed.rows(); ++i) {
+            update(X_processed.row(i).transpose(), y_processed(i));
+        }
+    } else {
+        reset(static_cast<int>(X.cols()));
+        for (int i = 0; i < X.rows(); ++i) {
+            update(X.row(i).transpose(), y(i));
+        }
+    }
+
+    this->has_sufficient_stats = false;
+    this->updateTrainingMetrics(X, y);
+
+    if (this->config.verbose) {
+        std::cout << "Online Linear Regression (RLS) training completed: "
+                  << samples_seen << " samples." << std::endl;
+        if (this->metrics_computed) {
+            std::cout << "R²: " << this->r_squared << ", MSE: " << this->mse << std::endl;
+        }
+    }
+}
+
+template<typename T>
+void OnlineLinearRegression<T>::saveWeights(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for writing: " + filename);
+    }
+
+    int size = static_cast<int>(this->weights.size());
+    int window = static_cast<int>(window_X.rows());
+    file.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    file.write(reinterpret_cast<const char*>(this->weights.data()), size * sizeof(T));
+    file.write(reinterpret_cast<const char*>(&samples_seen), sizeof(samples_seen));
+    if (P.rows() == size) {
+        file.write(reinterpret_cast<const char*>(P.data()), size * size * sizeof(T));
+    } else {
+        // Pesos vindos de fora do RLS (sem update ainda): P inicial
+        Eigen::MatrixX<T> initial = Eigen::MatrixX<T>::Identity(size, size) * this->config.rls_initial_variance;
+        file.write(reinterpret_cast<const char*>(initial.data()), size * size * sizeof(T));
+        window = 0;
+    }
+    file.write(reinterpret_cast<const char*>(&window), sizeof(window));
+    file.write(reinterpret_cast<const char*>(&window_head), sizeof(window_head));
+    file.write(reinterpret_cast<const char*>(&window_count), sizeof(window_count));
+    file.write(reinterpret_cast<const char*>(window_X.data()), window * size * sizeof(T));
+    file.write(reinterpret_cast<const char*>(window_y.data()), window * sizeof(T));
+    file.close();
+}
+
+template<typename T>
+void OnlineLinearRegression<T>::loadWeights(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        throw std::runtime_error("Cannot open file for reading: " + filename);
+    }
+
+    int size;
+    int window;
+    file.read(reinterpret_cast<char*>(&size), sizeof(size));
+    this->weights.resize(size);
+    file.read(reinterpret_cast<char*>(this->weights.data()), size * sizeof(T));
+    file.read(reinterpret_cast<char*>(&samples_seen), sizeof(samples_seen));
+    P.resize(size, size);
+    file.read(reinterpret_cast<char*>(P.data()), size * size * sizeof(T));
+    file.read(reinterpret_cast<char*>(&window), sizeof(window));
+    file.read(reinterpret_cast<char*>(&window_head), sizeof(window_head));
+    file.read(reinterpret_cast<char*>(&window_count), sizeof(window_count));
+    window_X.resize(window, size);
+    window_y.resize(window);
+    file.read(reinterpret_cast<char*>(window_X.data()), window * size * sizeof(T));
+    file.read(reinterpret_cast<char*>(window_y.data()), window * sizeof(T));
+    if (!file) {
+        throw std::runtime_error("Truncated online regression file: " + filename);
+    }
+    file.close();
+    Px = Eigen::VectorX<T>::Zero(size);
+}
+
+// Instanciações explícitas
+template class OnlineLinearRegression<float>;
+template class OnlineLinearRegression<double>;
@@ -1,11 +1,38 @@
 // src/PocketPLA.cpp
 #include "../include/PocketPLA.h"
 #include "../include/Metrics.h"
+#include "../include/ParallelFor.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <fstream>
 #include <iostream>
 #include <random>
 #include <stdexcept>
 
+namespace {
+
+const int MULTI_START_CHECKPOINTS = 16;   // rodadas sincronizadas do multi-start até max_iterations
+
+// Índice de um ponto mal classificado (e elegível) sorteado uniformemente
+// numa única varredura (reservoir sampling); -1 se não houver nenhum
+template<typename Mask>
+int sampleMisclassified(const Mask& misclassified, std::mt19937& rng) {
+    int chosen = -1;
+    int seen = 0;
+    for (int i = 0; i < misclassified.size(); ++i) {
+        if (misclassified[i]) {
+            ++seen;
+            if (std::uniform_int_distribution<int>(1, seen)(rng) == 1) {
+                chosen = i;
+            }
+        }
+    }
+    return chosen;
+}
+
+} // namespace
+
 template<typename T>
 PocketPLA<T>::PocketPLA() {
     config = TrainingConfig<T>();
@@ -15,7 +42,7 @@ template<typename T>
 PocketPLA<T>::PocketPLA(const TrainingConfig<T>& config) : config(config) {}
 
 template<typename T>
-void PocketPLA<T>::train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
+void PocketPLA<T>::train(const MatrixRef<T>& X, const VectorRef<T>& y) {
     if (this->preprocessing_enabled) {
         Eigen::MatrixX<T> X_processed = X;
         Eigen::VectorX<T> y_processed = y;
@@ -29,20 +56,78 @@ void PocketPLA<T>::train(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y)
 }
 
 template<typename T>
-void PocketPLA<T>::executeTraining(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) {
-    Eigen::VectorX<T> best_weights = weights;
-    T best_error = calculateError(X, y);
-    std::vector<T> error_history;
+void PocketPLA<T>::trainRowMajor(const RowMajorRef<T>& X, const VectorRef<T>& y) {
+    if (this->preprocessing_enabled) {
+        Model<T>::trainRowMajor(X, y);
+        return;
+    }
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    initializeWeights(X.cols());
+    executeTraining(X, y);
+}
+
+template<typename T>
+Eigen::VectorX<T> PocketPLA<T>::predictRowMajor(const RowMajorRef<T>& X) const {
+    return (X * weights).array().sign();
+}
+
+template<typename T>
+void PocketPLA<T>::trainSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X, const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    initializeWeights(X.cols());
+    executeTraining(X, y);
+}
+
+template<typename T>
+void PocketPLA<T>::trainWeighted(const MatrixRef<T>& X, const VectorRef<T>& y,
+                                 const VectorRef<T>& sample_weights) {
+    if (X.rows() != y.size() || sample_weights.size() != y.size()) {
+        throw std::invalid_argument("X, y and sample_weights must have the same number of rows");
+    }
+    if (sample_weights.sum() <= 0) {
+        throw std::invalid_argument("sample_weights must have a positive sum");
+    }
+    initializeWeights(X.cols());
+    executeTraining(X, y, &sample_weights);
+}
+
+template<typename T>
+template<typename Matrix>
+void PocketPLA<T>::executeTraining(const Matrix& X, const VectorRef<T>& y,
+                                   const VectorRef<T>* sample_weights) {
+    if (sample_weights == nullptr && config.pla_restarts > 1) {
+        executeMultiStart(X, y);
+        return;
+    }
+    
+    // Temporários na arena do modelo e histórico reaproveitando a capacidade
+    // do treino anterior: com workspace, o laço não aloca no heap
+    Workspace::Scope scratch(this->workspace.get());
+    auto predictions = scratch.vector<T>(y.size());
+    auto misclassified = scratch.vector<T>(y.size());   // 1 = mal classificado
+    auto best_weights = scratch.vector<T>(weights.size());
+    std::vector<T> error_history = std::move(training_metrics.training_history);
+    error_history.clear();
+    
+    const T total_weight = sample_weights ? sample_weights->sum() : static_cast<T>(y.size());
+    std::mt19937 rng(config.seed);
+    best_weights = weights;
+    T best_error = calculateError(X, y, sample_weights, predictions);
     
     bool converged = false;
     
     for (iterations = 0; iterations < config.max_iterations; ++iterations) {
         // Cálculo vetorizado - encontra pontos mal classificados
-        Eigen::VectorX<T> predictions = (X * weights).array().sign();
-        Eigen::Array<bool, Eigen::Dynamic, 1> misclassified = predictions.array() != y.array();
+        predictions.noalias() = X * weights;
+        misclassified = (predictions.array().sign() != y.array()).template cast<T>();
         
-        // Early stopping check
-        T current_error = misclassified.cast<T>().sum() / static_cast<T>(y.size());
+        // Early stopping check (erro ponderado quando há pesos por amostra)
+        T current_error = (sample_weights ? misclassified.dot(*sample_weights)
+                                          : misclassified.sum()) / total_weight;
         error_history.push_back(current_error);
         
         if (current_error < best_error) {
@@ -55,12 +140,19 @@ void PocketPLA<T>::executeTraining(const Eigen::MatrixX<T>& X, const Eigen::Vect
             break;
         }
         
-        // Encontra primeiro ponto mal classificado
+        // Encontra primeiro ponto mal classificado (com peso > 0), ou um sorteado
         int misclassified_index = -1;
-        for (int i = 0; i < misclassified.size(); ++i) {
-            if (misclassified[i]) {
-                misclassified_index = i;
-                break;
+        if (sample_weights) {
+            misclassified.array() *= (sample_weights->array() > static_cast<T>(0)).template cast<T>();
+        }
+        if (config.pla_random_selection) {
+            misclassified_index = sampleMisclassified(misclassified, rng);
+        } else {
+            for (int i = 0; i < misclassified.size(); ++i) {
+                if (misclassified[i]) {
+                    misclassified_index = i;
+                    break;
+                }
             }
         }
         
@@ -74,7 +166,7 @@ void PocketPLA<T>::executeTraining(const Eigen::MatrixX<T>& X, const Eigen::Vect
         
         // Atualiza pocket periodicamente
         if (iterations % config.pocket_update_frequency == 0) {
-            T error = calculateError(X, y);
+            T error = calculateError(X, y, sample_weights, predictions);
             if (error < best_error) {
                 best_error = error;
                 best_weights = weights;
@@ -86,19 +178,250 @@ void PocketPLA<T>::executeTraining(const Eigen::MatrixX<T>& X, const Eigen::Vect
     final_error = best_error;
     
     // Calcula métricas finais
-    Eigen::VectorX<T> final_predictions = predict(X);
+    predictions.noalias() = X * weights;
+    predictions = predictions.array().sign();
+    training_metrics = Metrics<T>::calculateClassificationMetrics(y, predictions);
+    training_metrics.training_history = std::move(error_history);
+    
+    if (config.verbose) {
+        std::cout << "Training completed: " << iterations << " iterations, "
+                  << "final error: " << final_error << ", "
+                  << "converged: " << (converged ? "yes" : "no") << std::endl;
+    }
+}
+
+template<typename T>
+template<typename Matrix>
+void PocketPLA<T>::executeMultiStart(const Matrix& X, const VectorRef<T>& y) {
+    const int n = static_cast<int>(y.size());
+    const int R = config.pla_restarts;
+    const int warmup = config.max_iterations / 4;
+    const int segment = std::max(1, config.max_iterations / MULTI_START_CHECKPOINTS);
+    const long abandon_errors = static_cast<long>(std::ceil(config.pla_abandon_margin * n));
+    
+    struct Chain {
+        std::mt19937 rng;
+        Eigen::VectorX<T> w;
+        int best_errors;
+        int iteration = 0;
+        bool active = true;
+        bool reached_tolerance = false;
+    };
+    std::vector<Chain> chains(R);
+    std::vector<Eigen::VectorX<T>> pockets(R);
+    std::vector<std::vector<T>> histories(R);
+    for (int chain = 0; chain < R; ++chain) {
+        Chain& state = chains[chain];
+        state.rng.seed(config.seed + static_cast<unsigned int>(chain));
+        // Cadeia 0 parte de zero (como o modo simples); as demais de pesos aleatórios
+        state.w = Eigen::VectorX<T>::Zero(X.cols());
+        if (chain > 0) {
+            std::normal_distribution<T> normal(0, 1);
+            for (int j = 0; j < state.w.size(); ++j) {
+                state.w(j) = normal(state.rng);
+            }
+        }
+        // O pocket parte do w inicial avaliado: toda cadeia tem ao menos um
+        // resultado, mesmo com max_iterations = 0
+        state.best_errors = n + 1;
+    }
+    
+    // Avança a cadeia até o checkpoint (ou até parar); só toca o próprio slot
+    auto runChain = [&](int chain, int checkpoint) {
+        Chain& state = chains[chain];
+        while (state.active && state.iteration < checkpoint) {
+            Eigen::Array<bool, Eigen::Dynamic, 1> misclassified = (X * state.w).array().sign() != y.array();
+            int errors = static_cast<int>(misclassified.count());
+            histories[chain].push_back(static_cast<T>(errors) / static_cast<T>(n));
+            
+            if (errors < state.best_errors) {
+                state.best_errors = errors;
+                pockets[chain] = state.w;
+            }
+            if (static_cast<T>(errors) / static_cast<T>(n) <= config.tolerance || errors == 0) {
+                state.reached_tolerance = true;
+                state.active = false;
+                break;
+            }
+            if (state.iteration >= config.max_iterations) {
+                state.active = false;
+                break;
+            }
+            
+            int index = sampleMisclassified(misclassified, state.rng);
+            state.w += y(index) * X.row(index).transpose();
+            ++state.iteration;
+        }
+    };
+    
+    // Melhor pocket: menos erros, empate pelo menor id de cadeia
+    auto bestChain = [&]() {
+        int best = 0;
+        for (int chain = 1; chain < R; ++chain) {
+            if (chains[chain].best_errors < chains[best].best_errors) {
+                best = chain;
+            }
+        }
+        return best;
+    };
+    
+    // Rodadas até checkpoints fixos; parada e abandono só são decididos entre
+    // rodadas, sobre o estado de todas as cadeias, então o resultado não
+    // depende do número de threads nem da ordem em que terminam
+    const int threads = parallelThreads(config.num_threads, R);
+    int abandoned = 0;
+    for (int checkpoint = segment;; checkpoint += segment) {
+        parallelFor(R, threads, [&](int chain, int) {
+            runChain(chain, checkpoint);
+        });
+        
+        bool any_active = false;
+        bool reached = false;
+        for (const Chain& state : chains) {
+            any_active = any_active || state.active;
+            reached = reached || state.reached_tolerance;
+        }
+        if (!any_active || reached) {
+            break;
+        }
+        
+        // Cadeia atrasada em relação ao melhor pocket do checkpoint: abandonada
+        const long global_errors = chains[bestChain()].best_errors;
+        for (Chain& state : chains) {
+            if (state.active && abandon_errors > 0 && state.iteration >= warmup &&
+                state.best_errors > global_errors + abandon_errors) {
+                state.active = false;
+                ++abandoned;
+            }
+        }
+    }
+    
+    const int best_chain = bestChain();
+    weights = pockets[best_chain];
+    final_error = static_cast<T>(chains[best_chain].best_errors) / static_cast<T>(n);
+    iterations = 0;
+    for (const Chain& state : chains) {
+        iterations += state.iteration;
+    }
+    
+    Eigen::VectorX<T> final_predictions = (X * weights).array().sign();
+    training_metrics = Metrics<T>::calculateClassificationMetrics(y, final_predictions);
+    training_metrics.training_history = histories[best_chain];
+    
+    if (config.verbose) {
+        std::cout << "Multi-start training completed: " << R << " chains on " << threads << " threads, "
+                  << iterations << " total iterations, best chain " << best_chain << ", "
+                  << "final error: " << final_error << ", abandoned chains: " << abandoned << std::endl;
+    }
+}
+
+template<typename T>
+void PocketPLA<T>::trainWithFeatureMap(const FeatureTransform<T>& map, const MatrixRef<T>& X,
+                                       const VectorRef<T>& y) {
+    if (X.rows() != y.size()) {
+        throw std::invalid_argument("X and y must have the same number of rows");
+    }
+    
+    const int n = static_cast<int>(X.rows());
+    const int block = map.blockRows();
+    Eigen::MatrixX<T> Z_block(block, map.outputDim());
+    
+    initializeWeights(map.outputDim());
+    Eigen::VectorX<T> best_weights = weights;
+    T best_error = 1;  // pesos nulos: sign(0) erra todos os pontos
+    std::vector<T> error_history;
+    bool converged = false;
+    int updates = 0;
+    
+    while (updates < config.max_iterations && !converged) {
+        int mistakes = 0;
+        for (int start = 0; start < n && updates < config.max_iterations; start += block) {
+            int rows = std::min(block, n - start);
+            map.transformBlock(X.middleRows(start, rows), Z_block.topRows(rows));
+            
+            for (int i = 0; i < rows && updates < config.max_iterations; ++i) {
+                T target = y(start + i);
+                T score = Z_block.row(i).dot(weights);
+                if ((score > 0 ? 1 : (score < 0 ? -1 : 0)) != target) {
+                    weights += target * Z_block.row(i).transpose();
+                    ++mistakes;
+                    ++updates;
+                }
+            }
+        }
+        
+        // Época sem erros: os pesos não mudaram, logo classificam tudo corretamente
+        if (mistakes == 0) {
+            best_weights = weights;
+            best_error = 0;
+            error_history.push_back(0);
+            converged = true;
+            break;
+        }
+        
+        T error = calculateMappedError(map, X, y, Z_block);
+        error_history.push_back(error);
+        if (error < best_error) {
+            best_error = error;
+            best_weights = weights;
+        }
+        if (error <= config.tolerance) {
+            converged = true;
+        }
+    }
+    
+    iterations = updates;
+    weights = best_weights;
+    final_error = best_error;
+    
+    Eigen::VectorX<T> final_predictions(n);
+    calculateMappedError(map, X, y, Z_block, &final_predictions);
     training_metrics = Metrics<T>::calculateClassificationMetrics(y, final_predictions);
     training_metrics.training_history = error_history;
     
     if (config.verbose) {
-        std::cout << "Training completed: " << iterations << " iterations, "
+        std::cout << "Training (feature map) completed: " << iterations << " updates, "
                   << "final error: " << final_error << ", "
                   << "converged: " << (converged ? "yes" : "no") << std::endl;
     }
 }
 
 template<typename T>
-Eigen::VectorX<T> PocketPLA<T>::predict(const Eigen::MatrixX<T>& X) const {
+T PocketPLA<T>::calculateMappedError(const FeatureTransform<T>& map, const MatrixRef<T>& X,
+                                     const VectorRef<T>& y, Eigen::MatrixX<T>& Z_block,
+                                     Eigen::VectorX<T>* predictions) const {
+    const int n = static_cast<int>(X.rows());
+    const int block = static_cast<int>(Z_block.rows());
+    int errors = 0;
+    
+    for (int start = 0; start < n; start += block) {
+        int rows = std::min(block, n - start);
+        map.transformBlock(X.middleRows(start, rows), Z_block.topRows(rows));
+        Eigen::VectorX<T> block_predictions = (Z_block.topRows(rows) * weights).array().sign();
+        errors += static_cast<int>((block_predictions.array() != y.segment(start, rows).array()).count());
+        if (predictions != nullptr) {
+            predictions->segment(start, rows) = block_predictions;
+        }
+    }
+    return static_cast<T>(errors) / static_cast<T>(n);
+}
+
+template<typename T>
+Eigen::VectorX<T> PocketPLA<T>::predict(const MatrixRef<T>& X) const {
+    return (X * weights).array().sign();
+}
+
+template<typename T>
+void PocketPLA<T>::predictInto(const MatrixRef<T>& X, Eigen::Ref<Eigen::VectorX<T>> out) const {
+    if (out.size() != X.rows()) {
+        throw std::invalid_argument("Output size must match the number of rows of X");
+    }
+    out.noalias() = X * weights;
+    out = out.array().sign();
+}
+
+template<typename T>
+Eigen::VectorX<T> PocketPLA<T>::predictSparse(const Eigen::SparseMatrix<T, Eigen::RowMajor>& X) const {
     return (X * weights).array().sign();
 }
 
@@ -130,10 +453,16 @@ void PocketPLA<T>::loadWeights(const std::string& filename) {
 }
 
 template<typename T>
-T PocketPLA<T>::calculateError(const Eigen::MatrixX<T>& X, const Eigen::VectorX<T>& y) const {
-    Eigen::VectorX<T> predictions = predict(X);
+template<typename Matrix>
+T PocketPLA<T>::calculateError(const Matrix& X, const VectorRef<T>& y, const VectorRef<T>* sample_weights,
+                               Eigen::Ref<Eigen::VectorX<T>> predictions) const {
+    predictions.noalias() = X * weights;
     // CORREÇÃO: usar template keyword para dependent names
-    return (predictions.array() != y.array()).template cast<T>().sum() / static_cast<T>(y.size());
+    auto wrong = (predictions.array().sign() != y.array()).template cast<T>();
+    if (sample_weights) {
+        return (wrong * sample_weights->array()).sum() / sample_weights->sum();
+    }
+    return wrong.sum() / static_cast<T>(y.size());
 }
 
 template<typename T>
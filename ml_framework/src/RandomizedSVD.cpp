@@ -0,0 +1,171 @@
+// src/RandomizedSVD.cpp
+#include "../include/RandomizedSVD.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <stdexcept>
+
+namespace {
+
+// Base ortonormal (d x l) da imagem de G via QR fino
+template<typename T>
+Eigen::MatrixX<T> orthonormalize(const Eigen::MatrixX<T>& G) {
+    Eigen::HouseholderQR<Eigen::MatrixX<T>> qr(G);
+    return qr.householderQ() * Eigen::MatrixX<T>::Identity(G.rows(), G.cols());
+}
+
+// Matriz de teste gaussiana (d x l)
+template<typename T>
+Eigen::MatrixX<T> gaussianMatrix(int rows, int cols, unsigned int seed) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<T> normal(0, 1);
+    Eigen::MatrixX<T> omega(rows, cols);
+    for (int j = 0; j < cols; ++j) {
+        for (int i = 0; i < rows; ++i) {
+            omega(i, j) = normal(rng);
+        }
+    }
+    return omega;
+}
+
+} // namespace
+
+template<typename T>
+RandomizedSVD<T>::RandomizedSVD(int rank, int oversampling, int power_iterations, unsigned int seed)
+    : rank(rank), oversampling(oversampling), power_iterations(power_iterations), seed(seed) {
+    if (rank <= 0) {
+        throw std::invalid_argument("rank must be positive");
+    }
+    if (oversampling < 0 || power_iterations < 0) {
+        throw std::invalid_argument("oversampling and power_iterations must be non-negative");
+    }
+}
+
+template<typename T>
+TruncatedSVD<T> RandomizedSVD<T>::compute(const Eigen::Ref<const Eigen::MatrixX<T>>& A, bool center,
+                                          int block_rows) const {
+    const int n = static_cast<int>(A.rows());
+    const int block = std::max(1, block_rows);
+    return run(static_cast<int>(A.cols()), center, [&](const BlockVisitor& visit) {
+        for (int start = 0; start < n; start += block) {
+            visit(A.middleRows(start, std::min(block, n - start)));
+        }
+    });
+}
+
+template<typename T>
+TruncatedSVD<T> RandomizedSVD<T>::compute(BatchSource<T>& source, bool center, int block_rows) const {
+    const int d = source.numFeatures();
+    const int block = std::max(1, block_rows);
+    Eigen::MatrixX<T> X_buffer(block, d);
+    Eigen::VectorX<T> y_buffer(block);
+    return run(d, center, [&](const BlockVisitor& visit) {
+        std::mt19937 rng(seed);
+        source.beginEpoch(rng, false);
+        int rows;
+        while ((rows = source.fill(X_buffer, y_buffer, block)) > 0) {
+            visit(X_buffer.topRows(rows));
+        }
+    });
+}
+
+template<typename T>
+TruncatedSVD<T> RandomizedSVD<T>::run(int d, bool center, const Pass& pass) const {
+    if (d <= 0) {
+        throw std::invalid_argument("Cannot compute an SVD of a matrix without columns");
+    }
+    const int l = std::min(rank + oversampling, d);
+    const int k = std::min(rank, l);
+
+    Eigen::MatrixX<T> omega = gaussianMatrix<T>(d, l, seed);
+
+    // G = A_c^T A_c Q sem formar A_c: A_c^T A_c = A^T A - n mean^T mean.
+    // A média sai da primeira passada, junto com o primeiro produto.
+    Eigen::RowVectorX<T> column_sum = Eigen::RowVectorX<T>::Zero(d);
+    Eigen::RowVectorX<T> mean = Eigen::RowVectorX<T>::Zero(d);
+    long n = 0;
+    bool first_pass = true;
+    Eigen::MatrixX<T> projected;
+
+    auto gramTimes = [&](const Eigen::MatrixX<T>& basis) {
+        Eigen::MatrixX<T> G = Eigen::MatrixX<T>::Zero(d, l);
+        pass([&](const Eigen::Ref<const Eigen::MatrixX<T>>& block) {
+            if (block.cols() != d) {
+                throw std::invalid_argument("Block dimension does not match the SVD input");
+            }
+            projected.noalias() = block * basis;
+            G.noalias() += block.transpose() * projected;
+            if (first_pass) {
+                column_sum += block.colwise().sum();
+                n += block.rows();
+            }
+        });
+        if (first_pass) {
+            if (n == 0) {
+                throw std::invalid_argument("Cannot compute an SVD of an empty matrix");
+            }
+            mean = column_sum / static_cast<T>(n);
+            first_pass = false;
+        }
+        if (center) {
+            G.noalias() -= static_cast<T>(n) * mean.transpose() * (mean * basis);
+        }
+        return G;
+    };
+
+    Eigen::MatrixX<T> Q = orthonormalize<T>(omega);
+    for (int it = 0; it < power_iterations; ++it) {
+        Q = orthonormalize<T>(gramTimes(Q));
+    }
+
+    // Rayleigh-Ritz na base final: C = Q^T A_c^T A_c Q (l x l)
+    Eigen::MatrixX<T> C = Q.transpose() * gramTimes(Q);
+    C = (C + C.transpose()) / static_cast<T>(2);
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixX<T>> eig(C);
+
+    TruncatedSVD<T> result;
+    result.V.resize(d, k);
+    result.S.resize(k);
+    for (int j = 0; j < k; ++j) {
+        int index = l - 1 - j;   // autovalores em ordem crescente
+        result.V.col(j).noalias() = Q * eig.eigenvectors().col(index);
+        result.S(j) = std::sqrt(std::max(eig.eigenvalues()(index), static_cast<T>(0)));
+    }
+    result.mean = center ? mean : Eigen::RowVectorX<T>::Zero(d);
+    result.num_samples = n;
+    return result;
+}
+
+template<typename T>
+TruncatedSVD<T> RandomizedSVD<T>::computeDirect(const Eigen::Ref<const Eigen::MatrixX<T>>& A) const {
+    const int n = static_cast<int>(A.rows());
+    const int d = static_cast<int>(A.cols());
+    if (n == 0 || d == 0) {
+        throw std::invalid_argument("Cannot compute an SVD of an empty matrix");
+    }
+    const int l = std::min(rank + oversampling, std::min(n, d));
+    const int k = std::min(rank, l);
+
+    // Iteração de subespaço reortonormalizando a cada produto: sem isso as
+    // direções fracas se perdem no arredondamento
+    Eigen::MatrixX<T> Q = orthonormalize<T>(A * gaussianMatrix<T>(d, l, seed));
+    for (int it = 0; it < power_iterations; ++it) {
+        Eigen::MatrixX<T> W = orthonormalize<T>(A.transpose() * Q);
+        Q = orthonormalize<T>(A * W);
+    }
+
+    Eigen::MatrixX<T> B = Q.transpose() * A;   // l x d
+    Eigen::JacobiSVD<Eigen::MatrixX<T>> svd(B, Eigen::ComputeThinU | Eigen::ComputeThinV);
+
+    TruncatedSVD<T> result;
+    result.U = Q * svd.matrixU().leftCols(k);
+    result.V = svd.matrixV().leftCols(k);
+    result.S = svd.singularValues().head(k);
+    result.mean = Eigen::RowVectorX<T>::Zero(d);
+    result.num_samples = n;
+    return result;
+}
+
+// Instanciações explícitas
+template class RandomizedSVD<float>;
+template class RandomizedSVD<double>;
@@ -0,0 +1,85 @@
+// src/Workspace.cpp
+#include "../include/Workspace.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::size_t roundUp(std::size_t bytes) {
+    return (bytes + Workspace::ALIGNMENT - 1) / Workspace::ALIGNMENT * Workspace::ALIGNMENT;
+}
+
+// Blocos alinhados a ALIGNMENT (>= EIGEN_MAX_ALIGN_BYTES, exigido pelos Map
+// AlignedMax). std::aligned_alloc é C++17: reserva ALIGNMENT bytes a mais com
+// std::malloc e guarda o ponteiro original logo antes do bloco alinhado
+char* allocateBlock(std::size_t bytes) {
+    void* original = std::malloc(bytes + Workspace::ALIGNMENT);
+    if (original == nullptr) {
+        throw std::bad_alloc();
+    }
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(original) + Workspace::ALIGNMENT;
+    char* block = reinterpret_cast<char*>(address & ~static_cast<std::uintptr_t>(Workspace::ALIGNMENT - 1));
+    reinterpret_cast<void**>(block)[-1] = original;
+    return block;
+}
+
+void freeBlock(char* block) {
+    std::free(reinterpret_cast<void**>(block)[-1]);
+}
+
+} // namespace
+
+Workspace::Workspace(std::size_t initial_bytes) {
+    if (initial_bytes > 0) {
+        buffer_size = roundUp(initial_bytes);
+        buffer = allocateBlock(buffer_size);
+    }
+}
+
+Workspace::~Workspace() {
+    for (const std::pair<std::size_t, char*>& block : overflow) {
+        freeBlock(block.second);
+    }
+    if (buffer) {
+        freeBlock(buffer);
+    }
+}
+
+void* Workspace::allocate(std::size_t bytes) {
+    bytes = roundUp(std::max<std::size_t>(bytes, 1));
+
+    // Arena vazia e pico acima da capacidade: cresce o bloco principal antes
+    // do primeiro pedido (feito aqui, e não no rewind, para que a arena
+    // temporária de um Scope sem Workspace não cresça à toa ao ser destruída)
+    if (used == 0 && peak > buffer_size) {
+        char* grown = allocateBlock(peak);
+        if (buffer) {
+            freeBlock(buffer);
+        }
+        buffer = grown;
+        buffer_size = peak;
+        ++growths;
+    }
+
+    char* region;
+    if (used + bytes <= buffer_size) {
+        region = buffer + used;
+    } else {
+        // Não cabe: bloco extra até o rewind que o liberar
+        region = allocateBlock(bytes);
+        overflow.emplace_back(used, region);
+    }
+    used += bytes;
+    peak = std::max(peak, used);
+    return region;
+}
+
+void Workspace::rewind(std::size_t mark) {
+    while (!overflow.empty() && overflow.back().first >= mark) {
+        freeBlock(overflow.back().second);
+        overflow.pop_back();
+    }
+    used = mark;
+}